@@ -0,0 +1,207 @@
+#include "BitBoard.h"
+#include <algorithm>
+
+BitBoard::BitBoard() {
+    resetBoard();
+}
+
+bool BitBoard::placeShip(const Ship& plane)
+{
+    const Position head = plane.getHead();
+    const auto* placement = PlacementTable::find(head.m_x, head.m_y, plane.getOrientation());
+    if (!placement || (placement->mask & m_shipMask).any())
+        return false;
+
+    const auto planeId = static_cast<std::int8_t>(m_ships.size());
+    for (int i = 0; i < PlacementTable::PART_COUNT; ++i) {
+        m_planeAt[placement->cells[i]] = planeId;
+        m_states[placement->cells[i]] = CellState::Ship;
+        m_partAt[placement->cells[i]] = static_cast<std::int8_t>(i);
+    }
+
+    m_shipMask |= placement->mask;
+    m_headMask.set(placement->head);
+    m_planeMasks.push_back(placement->mask);
+    m_ships.push_back(plane);
+    return true;
+}
+
+bool BitBoard::receiveShot(const Position& position)
+{
+    if (!isValid(position))
+        return false;
+
+    int cell = index(position);
+    if (m_hitMask.test(cell) || m_missMask.test(cell))
+        return false;
+
+    if (!m_shipMask.test(cell))
+    {
+        m_missMask.set(cell);
+        m_states[cell] = CellState::Miss;
+        return false;
+    }
+
+    m_hitMask.set(cell);
+    m_states[cell] = CellState::Hit;
+    m_destroyedMask.set(cell);
+
+    const int plane = m_planeAt[cell];
+    if (m_headMask.test(cell))
+        m_destroyedMask |= m_planeMasks[plane];
+    m_ships[plane].hitPart(m_partAt[cell]);
+
+    return true;
+}
+
+ShotBatchResult BitBoard::receiveShots(std::span<const Position> positions)
+{
+    ShotBatchResult result;
+    const auto count = std::min(positions.size(), ShotBatchResult::MAX_SHOTS);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Position& position = positions[i];
+        if (!isValid(position))
+            continue;
+
+        const int cell = index(position);
+        const std::uint64_t bit = std::uint64_t{ 1 } << i;
+        if (m_hitMask.test(cell) || m_missMask.test(cell))
+            continue;
+
+        if (!m_shipMask.test(cell))
+        {
+            m_missMask.set(cell);
+            m_states[cell] = CellState::Miss;
+            result.misses |= bit;
+            continue;
+        }
+
+        m_hitMask.set(cell);
+        m_states[cell] = CellState::Hit;
+        m_destroyedMask.set(cell);
+        result.hits |= bit;
+
+        const int plane = m_planeAt[cell];
+        const bool wasSunk = m_ships[plane].isSunk();
+        if (m_headMask.test(cell))
+        {
+            m_destroyedMask |= m_planeMasks[plane];
+            result.headKills |= bit;
+        }
+        m_ships[plane].hitPart(m_partAt[cell]);
+        if (!wasSunk && m_ships[plane].isSunk() && plane < ShotBatchResult::MAX_PLANES)
+            result.destroyedPlanes |= std::uint64_t{ 1 } << plane;
+    }
+
+    result.resolved = static_cast<int>(count);
+    return result;
+}
+
+int BitBoard::getShipsCount() const {
+    return static_cast<int>(m_ships.size());
+}
+
+int BitBoard::getSize() const {
+    return SIZE;
+}
+
+const std::vector<Ship>& BitBoard::getShips() const
+{
+    return m_ships;
+}
+
+CellState BitBoard::getCellState(const Position& position) const
+{
+    if (!isValid(position))
+        return CellState::Empty;
+
+    return m_states[index(position)];
+}
+
+void BitBoard::resetBoard()
+{
+    m_shipMask = {};
+    m_headMask = {};
+    m_hitMask = {};
+    m_missMask = {};
+    m_destroyedMask = {};
+    for (int cell = 0; cell < SIZE * SIZE; ++cell) {
+        m_planeAt[cell] = -1;
+        m_partAt[cell] = -1;
+        m_states[cell] = CellState::Empty;
+    }
+    m_planeMasks.clear();
+    m_ships.clear();
+}
+
+bool BitBoard::allShipsSunk() const
+{
+    return (m_shipMask & ~m_destroyedMask).none();
+}
+
+Cell BitBoard::getCellInfo(const Position& p) const
+{
+    if (!isValid(p)) return Cell{ p, CellState::Empty, false };
+    return Cell{ p, getCellState(p), m_headMask.test(index(p)) };
+}
+
+BoardView BitBoard::getView() const
+{
+    return BoardView{ SIZE, 2, m_shipMask.words, m_headMask.words, m_hitMask.words, m_missMask.words, m_states };
+}
+
+bool BitBoard::saveSnapshot(BoardSnapshot& snapshot) const
+{
+    if (m_ships.size() > static_cast<std::size_t>(BoardSnapshot::MAX_PLANES))
+        return false;
+
+    snapshot.hits = m_hitMask;
+    snapshot.misses = m_missMask;
+    snapshot.planeCount = static_cast<std::uint8_t>(m_ships.size());
+    for (std::size_t i = 0; i < m_ships.size(); ++i) {
+        const Position head = m_ships[i].getHead();
+        const auto* placement = PlacementTable::find(head.m_x, head.m_y, m_ships[i].getOrientation());
+        snapshot.placements[i] = static_cast<std::uint8_t>(placement - PlacementTable::PLACEMENTS.data());
+    }
+    return true;
+}
+
+bool BitBoard::loadSnapshot(const BoardSnapshot& snapshot)
+{
+    BitMask128 ships;
+    if (!snapshotShipMask(snapshot, ships))
+        return false;
+
+    resetBoard();
+    for (int i = 0; i < snapshot.planeCount; ++i) {
+        const auto& placement = PlacementTable::PLACEMENTS[snapshot.placements[i]];
+        placeShip(Ship(Position(placement.head % SIZE, placement.head / SIZE), placement.orientation));
+    }
+    snapshot.hits.forEachBit([this](int cell) { receiveShot(Position(cell % SIZE, cell / SIZE)); });
+    snapshot.misses.forEachBit([this](int cell) { receiveShot(Position(cell % SIZE, cell / SIZE)); });
+
+    return true;
+}
+
+bool BitBoard::canPlaceShip(const Ship& ship) const
+{
+    return canPlaceShipAt(ship.getHead(), ship.getOrientation());
+}
+
+bool BitBoard::canPlaceShipAt(const Position& head, Orientation orientation) const
+{
+    const auto* placement = PlacementTable::find(head.m_x, head.m_y, orientation);
+    return placement && (placement->mask & m_shipMask).none();
+}
+
+bool BitBoard::isValid(const Position& position) const
+{
+    return position.m_x >= 0 && position.m_x < SIZE && position.m_y >= 0 && position.m_y < SIZE;
+}
+
+int BitBoard::index(const Position& position)
+{
+    return position.m_y * SIZE + position.m_x;
+}
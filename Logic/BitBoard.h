@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "IBoard.h"
+#include "BitMask.h"
+#include "PlacementTable.h"
+#include "Ship.h"
+#include "Position.h"
+#include "CellState.h"
+#include "Cell.h"
+
+// IBoard implementation that keeps ship, hit, miss and head occupancy as 128 bit masks.
+class BitBoard final : public IBoard {
+private:
+    static constexpr int SIZE = 10;
+
+    BitMask128 m_shipMask;
+    BitMask128 m_headMask;
+    BitMask128 m_hitMask;
+    BitMask128 m_missMask;
+    // cells of planes that are already down (hit parts + planes with a hit head)
+    BitMask128 m_destroyedMask;
+    CellState m_states[SIZE * SIZE];
+    std::vector<BitMask128> m_planeMasks;
+    // index in m_ships and part index of the plane covering each cell, -1 when empty
+    std::int8_t m_planeAt[SIZE * SIZE];
+    std::int8_t m_partAt[SIZE * SIZE];
+    std::vector<Ship> m_ships;
+
+public:
+    BitBoard();
+
+    bool receiveShot(const Position& position) override;
+    ShotBatchResult receiveShots(std::span<const Position> positions) override;
+    void resetBoard() override;
+    CellState getCellState(const Position& position) const override;
+    int getShipsCount() const override;
+    int getSize() const override;
+    const std::vector<Ship>& getShips() const override;
+
+    bool placeShip(const Ship& plane) override;
+
+    bool allShipsSunk() const override;
+
+    Cell getCellInfo(const Position& p) const override;
+    BoardView getView() const override;
+    bool saveSnapshot(BoardSnapshot& snapshot) const override;
+    bool loadSnapshot(const BoardSnapshot& snapshot) override;
+    bool canPlaceShip(const Ship& ship) const override;
+    bool canPlaceShipAt(const Position& head, Orientation orientation) const override;
+
+private:
+    bool isValid(const Position& position) const;
+    static int index(const Position& position);
+};
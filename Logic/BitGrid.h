@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Runtime-sized bit set with one bit per board cell, used by boards larger than 10x10.
+class BitGrid {
+private:
+    std::vector<std::uint64_t> m_words;
+    int m_bitCount{ 0 };
+
+public:
+    BitGrid() = default;
+    explicit BitGrid(int bitCount)
+        : m_words((bitCount + 63) / 64, 0), m_bitCount(bitCount) {
+    }
+
+    bool test(int index) const { return (m_words[index >> 6] >> (index & 63)) & 1u; }
+    void set(int index) { m_words[index >> 6] |= std::uint64_t{ 1 } << (index & 63); }
+    void reset(int index) { m_words[index >> 6] &= ~(std::uint64_t{ 1 } << (index & 63)); }
+
+    void clear()
+    {
+        for (auto& word : m_words)
+            word = 0;
+    }
+
+    int size() const { return m_bitCount; }
+    int wordCount() const { return static_cast<int>(m_words.size()); }
+    const std::uint64_t* data() const { return m_words.data(); }
+};
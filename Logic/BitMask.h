@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace BitOps
+{
+	inline int popcount(std::uint64_t value)
+	{
+#if defined(_MSC_VER)
+		return static_cast<int>(__popcnt64(value));
+#else
+		return __builtin_popcountll(value);
+#endif
+	}
+
+	// value must be non-zero
+	inline int lowestBit(std::uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctzll(value);
+#endif
+	}
+}
+
+// 128 bit set, enough for one bit per cell of a 10x10 board (index = y * 10 + x).
+struct BitMask128 {
+	std::uint64_t words[2]{ 0, 0 };
+
+	static constexpr BitMask128 fromBit(int index)
+	{
+		BitMask128 mask;
+		mask.set(index);
+		return mask;
+	}
+
+	constexpr bool test(int index) const
+	{
+		return (words[index >> 6] >> (index & 63)) & 1u;
+	}
+
+	constexpr void set(int index)
+	{
+		words[index >> 6] |= std::uint64_t{ 1 } << (index & 63);
+	}
+
+	constexpr void reset(int index)
+	{
+		words[index >> 6] &= ~(std::uint64_t{ 1 } << (index & 63));
+	}
+
+	constexpr bool none() const { return (words[0] | words[1]) == 0; }
+	constexpr bool any() const { return !none(); }
+
+	int count() const { return BitOps::popcount(words[0]) + BitOps::popcount(words[1]); }
+
+	constexpr BitMask128 operator&(const BitMask128& other) const
+	{
+		BitMask128 result;
+		result.words[0] = words[0] & other.words[0];
+		result.words[1] = words[1] & other.words[1];
+		return result;
+	}
+
+	constexpr BitMask128 operator|(const BitMask128& other) const
+	{
+		BitMask128 result;
+		result.words[0] = words[0] | other.words[0];
+		result.words[1] = words[1] | other.words[1];
+		return result;
+	}
+
+	constexpr BitMask128 operator^(const BitMask128& other) const
+	{
+		BitMask128 result;
+		result.words[0] = words[0] ^ other.words[0];
+		result.words[1] = words[1] ^ other.words[1];
+		return result;
+	}
+
+	constexpr BitMask128 operator~() const
+	{
+		BitMask128 result;
+		result.words[0] = ~words[0];
+		result.words[1] = ~words[1];
+		return result;
+	}
+
+	constexpr BitMask128& operator&=(const BitMask128& other) { return *this = *this & other; }
+	constexpr BitMask128& operator|=(const BitMask128& other) { return *this = *this | other; }
+	constexpr BitMask128& operator^=(const BitMask128& other) { return *this = *this ^ other; }
+
+	constexpr bool operator==(const BitMask128& other) const
+	{
+		return words[0] == other.words[0] && words[1] == other.words[1];
+	}
+
+	constexpr bool operator!=(const BitMask128& other) const { return !(*this == other); }
+
+	template <typename Fn>
+	void forEachBit(Fn&& fn) const
+	{
+		for (int w = 0; w < 2; ++w)
+		{
+			std::uint64_t bits = words[w];
+			while (bits)
+			{
+				fn(w * 64 + BitOps::lowestBit(bits));
+				bits &= bits - 1;
+			}
+		}
+	}
+};
@@ -1,5 +1,8 @@
 ﻿#include "Board.h"
-#include <iostream>
+#include <algorithm>
+#include "Zobrist.h"
+
+static_assert(Board::SIZE == PlacementTable::BOARD_SIZE, "placement table is generated for the classic board");
 
 Board::Board() {
     resetBoard();
@@ -7,7 +10,9 @@ Board::Board() {
 
 bool Board::placeShip(const Ship& plane)
 {
-    if (placeShipParts(plane.getParts())) {
+    const Position head = plane.getHead();
+    const auto* placement = PlacementTable::find(head.m_x, head.m_y, plane.getOrientation());
+    if (placement && placeShipParts(*placement)) {
         m_ships.push_back(plane);
         return true;
     }
@@ -16,29 +21,75 @@ bool Board::placeShip(const Ship& plane)
 
 bool Board::receiveShot(const Position& position)
 {
-    if (!isValid(position))
+    if (!isValid(position)) {
+        recordShot({ -1, CellState::Empty, -1, 0 });
         return false;
+    }
 
-    Cell& cell = cells[position.m_y][position.m_x];
+    const auto cell = static_cast<std::int8_t>(index(position));
+    CellState& state = m_states[cell];
 
-    if (cell.state == CellState::Ship)
+    if (state == CellState::Ship)
     {
-        cell.state = CellState::Hit;
+        const std::int8_t plane = m_planeAt[position.m_y][position.m_x];
+        recordShot({ cell, state, plane, m_ships[plane].getHitMask() });
 
-        for (auto& ship : m_ships)
-            if (ship.contains(position))
-                ship.hit(position);
+        state = CellState::Hit;
+        m_hitMask.set(cell);
+        m_ships[plane].hitPart(m_partAt[position.m_y][position.m_x]);
+        m_observationHash ^= Zobrist::key(Zobrist::HitCell, cell);
+        if (m_headMask.test(cell))
+            m_observationHash ^= Zobrist::key(Zobrist::HeadKill, cell);
 
         return true; 
     }
-    else if (cell.state == CellState::Empty)
+    else if (state == CellState::Empty)
+    {
+        recordShot({ cell, state, -1, 0 });
+        state = CellState::Miss;
+        m_missMask.set(cell);
+        m_observationHash ^= Zobrist::key(Zobrist::MissCell, cell);
+    }
+    else
     {
-        cell.state = CellState::Miss;
+        recordShot({ -1, state, -1, 0 });
     }
 
     return false;
 }
 
+ShotBatchResult Board::receiveShots(std::span<const Position> positions)
+{
+    ShotBatchResult result;
+    const auto count = std::min(positions.size(), ShotBatchResult::MAX_SHOTS);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Position& position = positions[i];
+        const std::uint64_t bit = std::uint64_t{ 1 } << i;
+        const bool valid = isValid(position);
+        const CellState before = valid ? m_states[index(position)] : CellState::Empty;
+        const int plane = valid ? m_planeAt[position.m_y][position.m_x] : -1;
+        const bool wasSunk = plane >= 0 && m_ships[plane].isSunk();
+
+        if (Board::receiveShot(position))
+        {
+            result.hits |= bit;
+            if (m_headMask.test(index(position)))
+                result.headKills |= bit;
+            if (!wasSunk && m_ships[plane].isSunk() && plane < ShotBatchResult::MAX_PLANES)
+                result.destroyedPlanes |= std::uint64_t{ 1 } << plane;
+        }
+        else if (before == CellState::Empty && valid)
+        {
+            result.misses |= bit;
+        }
+    }
+
+    result.resolved = static_cast<int>(count);
+    return result;
+}
+
 int Board::getShipsCount() const {
     return m_ships.size();
 }
@@ -57,29 +108,46 @@ CellState Board::getCellState(const Position& position) const
     if (!isValid(position))
         return CellState::Empty;
 
-    return cells[position.m_y][position.m_x].state;
+    return m_states[index(position)];
 }
 
 void Board::resetBoard()
 {
     for (int y =0; y < SIZE; ++y)
         for (int x =0; x < SIZE; ++x)
-            cells[y][x] = { {x, y}, CellState::Empty, false };
+        {
+            m_states[y * SIZE + x] = CellState::Empty;
+            m_planeAt[y][x] = -1;
+            m_partAt[y][x] = -1;
+        }
 
+    m_shipMask = {};
+    m_headMask = {};
+    m_hitMask = {};
+    m_missMask = {};
+    m_observationHash = 0;
+    m_layoutHash = 0;
     m_ships.clear();
+    clearJournal();
 }
 
-bool Board::placeShipParts(const std::vector<ShipPart>& parts)
+bool Board::placeShipParts(const PlacementTable::Placement& placement)
 {
-    for (auto& part : parts) {
-        if (!isValid(part.getPosition()) || cells[part.getPosition().m_y][part.getPosition().m_x].state != CellState::Empty)
-            return false;
-    }
+    if ((placement.mask & m_shipMask).any())
+        return false;
 
-    for (auto& part : parts) {
-        cells[part.getPosition().m_y][part.getPosition().m_x].state = CellState::Ship;
-        if (part.isHeadPart()) cells[part.getPosition().m_y][part.getPosition().m_x].isHead = true;
+    const auto plane = static_cast<std::int8_t>(m_ships.size());
+    for (int i = 0; i < PlacementTable::PART_COUNT; ++i) {
+        int y = placement.cells[i] / SIZE;
+        int x = placement.cells[i] % SIZE;
+        m_states[placement.cells[i]] = CellState::Ship;
+        m_planeAt[y][x] = plane;
+        m_partAt[y][x] = static_cast<std::int8_t>(i);
+        m_layoutHash ^= Zobrist::key(Zobrist::ShipCell, placement.cells[i]);
     }
+    m_headMask.set(placement.head);
+    m_layoutHash ^= Zobrist::key(Zobrist::HeadCell, placement.head);
+    m_shipMask |= placement.mask;
 
     return true;
 }
@@ -89,37 +157,9 @@ bool Board::isValid(const Position& position) const
     return position.m_x >=0 && position.m_x < SIZE && position.m_y >=0 && position.m_y < SIZE;
 }
 
-void Board::print() const
+int Board::index(const Position& position)
 {
-    std::cout << "\n ";
-    for (int x =0; x < SIZE; ++x)
-        std::cout << x << " ";
-    std::cout << "\n";
-
-    for (int y =0; y < SIZE; ++y)
-    {
-        std::cout << (y <10 ? " " : "") << y << " ";
-        for (int x =0; x < SIZE; ++x)
-        {
-            char cell;
-            switch (cells[y][x].state)
-            {
-            case CellState::Empty: cell = '.'; break;
-            case CellState::Ship:  cell = 'S'; break;
-            case CellState::Hit:   cell = 'X'; break;
-            case CellState::Miss:  cell = 'o'; break;
-            default: cell = '?'; break;
-            }
-            std::cout << cell << ' ';
-        }
-        std::cout << "\n";
-    }
-
-    std::cout << "\nLegenda: "
-        << "'.' = gol, "
-        << "'S' = nava, "
-        << "'X' = lovit, "
-        << "'o' = ratat\n";
+    return position.m_y * SIZE + position.m_x;
 }
 
 bool Board::allShipsSunk() const
@@ -134,13 +174,130 @@ bool Board::allShipsSunk() const
 
 Cell Board::getCellInfo(const Position& p) const {
  if (!isValid(p)) return Cell{ p, CellState::Empty, false };
- return cells[p.m_y][p.m_x];
+ return Cell{ p, m_states[index(p)], m_headMask.test(index(p)) };
 }
 
 bool Board::canPlaceShip(const Ship& ship) const {
- for (const auto& part : ship.getParts()) {
- if (!isValid(part.getPosition())) return false;
- if (cells[part.getPosition().m_y][part.getPosition().m_x].state != CellState::Empty) return false;
- }
- return true;
+ return canPlaceShipAt(ship.getHead(), ship.getOrientation());
+}
+
+bool Board::canPlaceShipAt(const Position& head, Orientation orientation) const {
+ const auto* placement = PlacementTable::find(head.m_x, head.m_y, orientation);
+ return placement && (placement->mask & m_shipMask).none();
+}
+
+bool Board::undoShot()
+{
+    if (m_journalSize == 0)
+        return false;
+
+    m_journalTop = (m_journalTop + JOURNAL_CAPACITY - 1) % JOURNAL_CAPACITY;
+    --m_journalSize;
+
+    const ShotRecord& record = m_journal[m_journalTop];
+    if (record.cell >= 0) {
+        if (m_states[record.cell] == CellState::Miss) {
+            m_observationHash ^= Zobrist::key(Zobrist::MissCell, record.cell);
+        }
+        else {
+            m_observationHash ^= Zobrist::key(Zobrist::HitCell, record.cell);
+            if (m_headMask.test(record.cell))
+                m_observationHash ^= Zobrist::key(Zobrist::HeadKill, record.cell);
+        }
+        m_states[record.cell] = record.previousState;
+        m_hitMask.reset(record.cell);
+        m_missMask.reset(record.cell);
+    }
+    if (record.plane >= 0)
+        m_ships[record.plane].restoreHitMask(record.previousHitMask);
+
+    return true;
+}
+
+BoardView Board::getView() const
+{
+    return BoardView{ SIZE, 2, m_shipMask.words, m_headMask.words, m_hitMask.words, m_missMask.words, m_states };
+}
+
+bool Board::saveSnapshot(BoardSnapshot& snapshot) const
+{
+    if (m_ships.size() > static_cast<std::size_t>(BoardSnapshot::MAX_PLANES))
+        return false;
+
+    snapshot.hits = m_hitMask;
+    snapshot.misses = m_missMask;
+    snapshot.planeCount = static_cast<std::uint8_t>(m_ships.size());
+    for (std::size_t i = 0; i < m_ships.size(); ++i) {
+        const Position head = m_ships[i].getHead();
+        const auto* placement = PlacementTable::find(head.m_x, head.m_y, m_ships[i].getOrientation());
+        snapshot.placements[i] = static_cast<std::uint8_t>(placement - PlacementTable::PLACEMENTS.data());
+    }
+    return true;
+}
+
+bool Board::loadSnapshot(const BoardSnapshot& snapshot)
+{
+    BitMask128 ships;
+    if (!snapshotShipMask(snapshot, ships))
+        return false;
+
+    resetBoard();
+    for (int i = 0; i < snapshot.planeCount; ++i) {
+        const auto& placement = PlacementTable::PLACEMENTS[snapshot.placements[i]];
+        placeShipParts(placement);
+        m_ships.emplace_back(Position(placement.head % SIZE, placement.head / SIZE), placement.orientation);
+    }
+
+    // same bookkeeping as receiveShot, without the journal
+    snapshot.hits.forEachBit([this](int cell) {
+        const int y = cell / SIZE;
+        const int x = cell % SIZE;
+        m_states[cell] = CellState::Hit;
+        m_ships[m_planeAt[y][x]].hitPart(m_partAt[y][x]);
+        m_observationHash ^= Zobrist::key(Zobrist::HitCell, cell);
+        if (m_headMask.test(cell))
+            m_observationHash ^= Zobrist::key(Zobrist::HeadKill, cell);
+    });
+    snapshot.misses.forEachBit([this](int cell) {
+        m_states[cell] = CellState::Miss;
+        m_observationHash ^= Zobrist::key(Zobrist::MissCell, cell);
+    });
+    m_hitMask = snapshot.hits;
+    m_missMask = snapshot.misses;
+
+    return true;
+}
+
+BitMask128 Board::getShotMask() const
+{
+    return m_hitMask | m_missMask;
+}
+
+std::uint64_t Board::getObservationHash() const
+{
+    return m_observationHash;
+}
+
+std::uint64_t Board::getLayoutHash() const
+{
+    return m_layoutHash;
+}
+
+int Board::getJournalSize() const
+{
+    return m_journalSize;
+}
+
+void Board::clearJournal()
+{
+    m_journalTop = 0;
+    m_journalSize = 0;
+}
+
+void Board::recordShot(const ShotRecord& record)
+{
+    m_journal[m_journalTop] = record;
+    m_journalTop = (m_journalTop + 1) % JOURNAL_CAPACITY;
+    if (m_journalSize < JOURNAL_CAPACITY)
+        ++m_journalSize;
 }
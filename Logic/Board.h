@@ -1,20 +1,50 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <vector>
 #include "IBoard.h"
 #include "Ship.h"
 #include "Position.h"
 #include "CellState.h"
 #include "Cell.h"
-class Board : public IBoard {
-private:
+#include "BitMask.h"
+#include "PlacementTable.h"
+class Board final : public IBoard {
+public:
     static constexpr int SIZE = 10;
-    Cell cells[SIZE][SIZE];
+
+private:
+    CellState m_states[SIZE * SIZE];
+    BitMask128 m_shipMask;
+    BitMask128 m_headMask;
+    BitMask128 m_hitMask;
+    BitMask128 m_missMask;
+    std::uint64_t m_observationHash{ 0 };
+    std::uint64_t m_layoutHash{ 0 };
+    // index in m_ships and part index of the plane covering each cell, -1 when empty
+    std::int8_t m_planeAt[SIZE][SIZE];
+    std::int8_t m_partAt[SIZE][SIZE];
     std::vector<Ship> m_ships;
 
+    // What a receiveShot call changed, so undoShot can put it back.
+    struct ShotRecord {
+        std::int8_t cell;           // y * SIZE + x, -1 when the shot changed nothing
+        CellState previousState;
+        std::int8_t plane;          // -1 when no plane was hit
+        std::uint16_t previousHitMask;
+    };
+
+    // newest records win once the ring is full; undo depth is capped at JOURNAL_CAPACITY
+    static constexpr int JOURNAL_CAPACITY = 256;
+    std::array<ShotRecord, JOURNAL_CAPACITY> m_journal;
+    int m_journalTop{ 0 };
+    int m_journalSize{ 0 };
+
 public:
     Board();
 
     bool receiveShot(const Position& position) override;
+    ShotBatchResult receiveShots(std::span<const Position> positions) override;
     void resetBoard() override;
     CellState getCellState(const Position& position) const override;
     int getShipsCount() const;
@@ -23,16 +53,31 @@ public:
 
     bool placeShip(const Ship& plane) override;
 
-    void print() const override;
-
     bool allShipsSunk() const override;
 
     // New
     Cell getCellInfo(const Position& p) const override;
     bool canPlaceShip(const Ship& ship) const override;
+    bool canPlaceShipAt(const Position& head, Orientation orientation) const override;
+
+    BoardView getView() const override;
+    bool saveSnapshot(BoardSnapshot& snapshot) const override;
+    bool loadSnapshot(const BoardSnapshot& snapshot) override;
+    BitMask128 getShotMask() const;
+
+    // Zobrist hashes: hits, misses and head kills seen by the shooter / the full hidden layout.
+    std::uint64_t getObservationHash() const;
+    std::uint64_t getLayoutHash() const;
+
+    // Shot journal: every receiveShot call is recorded and can be rolled back in O(1).
+    bool undoShot();
+    int getJournalSize() const;
+    void clearJournal();
 
 private:
-    bool placeShipParts(const std::vector<ShipPart>& parts);
+    bool placeShipParts(const PlacementTable::Placement& placement);
     bool isValid(const Position& position) const;
+    static int index(const Position& position);
+    void recordShot(const ShotRecord& record);
 
 };
@@ -0,0 +1,26 @@
+#pragma once
+#include <memory>
+#include "IBoard.h"
+
+// Shared IBoard seen through the interface GameCore expects, so Game can run the same rules on
+// the boards its players own. A missing board behaves like an empty one that accepts nothing.
+class BoardHandle {
+public:
+    BoardHandle(std::shared_ptr<IBoard> board = nullptr) : m_board(std::move(board)) {}
+
+    void resetBoard() { if (m_board) m_board->resetBoard(); }
+    bool canPlaceShipAt(const Position& head, Orientation orientation) const { return m_board && m_board->canPlaceShipAt(head, orientation); }
+    bool placeShip(const Ship& plane) { return m_board && m_board->placeShip(plane); }
+    bool receiveShot(const Position& position) { return m_board && m_board->receiveShot(position); }
+    Cell getCellInfo(const Position& position) const { return m_board ? m_board->getCellInfo(position) : Cell{ position, CellState::Empty, false }; }
+    bool allShipsSunk() const { return m_board && m_board->allShipsSunk(); }
+    int getShipsCount() const { return m_board ? m_board->getShipsCount() : 0; }
+    bool saveSnapshot(BoardSnapshot& snapshot) const { return m_board && m_board->saveSnapshot(snapshot); }
+    bool loadSnapshot(const BoardSnapshot& snapshot) { return m_board && m_board->loadSnapshot(snapshot); }
+
+    const std::shared_ptr<IBoard>& get() const { return m_board; }
+    explicit operator bool() const { return static_cast<bool>(m_board); }
+
+private:
+    std::shared_ptr<IBoard> m_board;
+};
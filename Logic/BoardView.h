@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include "CellState.h"
+
+// Read-only, non-owning view over a board's internal storage. Masks hold one bit per cell
+// (index = y * size + x) in wordCount 64-bit words; states holds size * size entries, row by row.
+// The pointers stay valid until the board is destroyed; contents follow later shots and placements.
+struct BoardView {
+    int size{ 0 };
+    int wordCount{ 0 };
+    const std::uint64_t* ships{ nullptr };
+    const std::uint64_t* heads{ nullptr };
+    const std::uint64_t* hits{ nullptr };
+    const std::uint64_t* misses{ nullptr };
+    const CellState* states{ nullptr };
+
+    static bool test(const std::uint64_t* mask, int index)
+    {
+        return (mask[index >> 6] >> (index & 63)) & 1u;
+    }
+
+    CellState stateAt(int x, int y) const { return states[y * size + x]; }
+    bool isHead(int x, int y) const { return test(heads, y * size + x); }
+};
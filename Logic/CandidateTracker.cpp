@@ -0,0 +1,170 @@
+#include "CandidateTracker.h"
+#include <algorithm>
+#include "PlacementTable.h"
+
+CandidateTracker::CandidateTracker(int boardSize)
+{
+    reset(boardSize);
+}
+
+void CandidateTracker::build(int boardSize)
+{
+    m_size = std::max(boardSize, 0);
+    const int cellCount = m_size * m_size;
+    m_placements.clear();
+    for (int y = 0; y < m_size; ++y) {
+        for (int x = 0; x < m_size; ++x) {
+            for (int o = 0; o < PlacementTable::ORIENTATION_COUNT; ++o) {
+                Placement placement;
+                placement.head = y * m_size + x;
+                placement.orientation = static_cast<Orientation>(o);
+                bool fits = true;
+                for (int i = 0; i < PlacementTable::PART_COUNT && fits; ++i) {
+                    int px = x + PlacementTable::OFFSETS[o][i].x;
+                    int py = y + PlacementTable::OFFSETS[o][i].y;
+                    fits = px >= 0 && px < m_size && py >= 0 && py < m_size;
+                    placement.cells[i] = py * m_size + px;
+                }
+                if (fits)
+                    m_placements.push_back(placement);
+            }
+        }
+    }
+
+    m_initialCounts.assign(cellCount, 0);
+    m_initialHeadCounts.assign(cellCount, 0);
+    for (const Placement& placement : m_placements) {
+        for (int cell : placement.cells)
+            ++m_initialCounts[cell];
+        ++m_initialHeadCounts[placement.head];
+    }
+
+    m_coverStart.assign(cellCount + 1, 0);
+    for (int cell = 0; cell < cellCount; ++cell)
+        m_coverStart[cell + 1] = m_coverStart[cell] + static_cast<int>(m_initialCounts[cell]);
+    m_cover.resize(m_coverStart[cellCount]);
+    std::vector<int> next(m_coverStart.begin(), m_coverStart.end() - 1);
+    for (int id = 0; id < static_cast<int>(m_placements.size()); ++id) {
+        for (int cell : m_placements[id].cells)
+            m_cover[next[cell]++] = id;
+    }
+}
+
+void CandidateTracker::reset(int boardSize)
+{
+    if (boardSize != m_size || m_coverStart.empty())
+        build(boardSize);
+    m_live.assign((m_placements.size() + 63) / 64, ~std::uint64_t{ 0 });
+    if (m_placements.size() % 64)
+        m_live.back() = (std::uint64_t{ 1 } << (m_placements.size() % 64)) - 1;
+    m_shot.assign(m_initialCounts.size(), 0);
+    m_counts = m_initialCounts;
+    m_headCounts = m_initialHeadCounts;
+    m_candidates = static_cast<int>(m_placements.size());
+}
+
+void CandidateTracker::follow(const IGame& game, std::shared_ptr<IPlayer> shooter)
+{
+    m_game = &game;
+    m_shooter = shooter;
+    reset(game.getGridSize());
+}
+
+void CandidateTracker::drop(int placement)
+{
+    const std::uint64_t bit = std::uint64_t{ 1 } << (placement & 63);
+    if (!(m_live[placement >> 6] & bit))
+        return;
+    m_live[placement >> 6] &= ~bit;
+    const Placement& dropped = m_placements[placement];
+    for (int cell : dropped.cells)
+        --m_counts[cell];
+    --m_headCounts[dropped.head];
+    --m_candidates;
+}
+
+void CandidateTracker::record(int x, int y, bool hit, bool head)
+{
+    if (x < 0 || x >= m_size || y < 0 || y >= m_size)
+        return;
+    const int cell = y * m_size + x;
+    if (m_shot[cell])
+        return;
+    m_shot[cell] = 1;
+
+    for (int i = m_coverStart[cell]; i < m_coverStart[cell + 1]; ++i) {
+        const int id = m_cover[i];
+        // a miss rules out the cell entirely, a hit only the placements with the head wrong
+        if (!hit || (m_placements[id].head == cell) != head)
+            drop(id);
+    }
+}
+
+void CandidateTracker::onShipPlaced(const Ship&)
+{
+}
+
+void CandidateTracker::onShotFired(const Cell& cell, GameState)
+{
+    // the listener hears both players; the turn has not switched yet when a shot is reported
+    if (m_game && m_game->getCurrentPlayer().lock() != m_shooter.lock())
+        return;
+    record(cell.position.m_x, cell.position.m_y, cell.state == CellState::Hit, cell.isHead);
+}
+
+void CandidateTracker::onGameStateChanged(GameState newState)
+{
+    if (newState == GameState::PlacingShips)
+        reset(m_game ? m_game->getGridSize() : m_size);
+}
+
+int CandidateTracker::getBoardSize() const
+{
+    return m_size;
+}
+
+int CandidateTracker::getPlacementCount() const
+{
+    return static_cast<int>(m_placements.size());
+}
+
+int CandidateTracker::getCandidateCount() const
+{
+    return m_candidates;
+}
+
+bool CandidateTracker::isCandidate(int placement) const
+{
+    return placement >= 0 && placement < static_cast<int>(m_placements.size()) && ((m_live[placement >> 6] >> (placement & 63)) & 1u);
+}
+
+Position CandidateTracker::getHead(int placement) const
+{
+    const int head = m_placements[placement].head;
+    return Position(head % m_size, head / m_size);
+}
+
+Orientation CandidateTracker::getOrientation(int placement) const
+{
+    return m_placements[placement].orientation;
+}
+
+std::span<const int> CandidateTracker::getCovering(int cell) const
+{
+    return std::span<const int>(m_cover.data() + m_coverStart[cell], m_cover.data() + m_coverStart[cell + 1]);
+}
+
+const std::vector<std::uint64_t>& CandidateTracker::getLive() const
+{
+    return m_live;
+}
+
+const std::vector<std::uint32_t>& CandidateTracker::getCounts() const
+{
+    return m_counts;
+}
+
+const std::vector<std::uint32_t>& CandidateTracker::getHeadCounts() const
+{
+    return m_headCounts;
+}
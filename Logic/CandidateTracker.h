@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "IGame.h"
+#include "IGameListener.h"
+
+// Every single-plane placement on one board that still fits the shots seen so far, kept up to
+// date as shots come in: a miss drops the placements covering the cell, a hit drops the ones
+// that disagree about a head there. A cell -> placement index (CSR) means a shot only walks the
+// placements on that cell, and the per-cell counts are decremented as placements drop, so
+// nothing is recounted between turns.
+//
+// Placement ids run over head cells (y * size + x), then orientations, as in PlacementTable, so
+// on the classic board they are PlacementTable ids. DensityShooter and LayoutSampler take their
+// candidate sets from here instead of rescanning every placement each turn.
+class CandidateTracker : public IGameListener {
+public:
+    explicit CandidateTracker(int boardSize = 10);
+
+    // Only track shots fired on the shooter's turn (by default every shot is tracked). A new
+    // game on this IGame starts over at its grid size. This does not register the tracker;
+    // the caller still passes it to game.addListener().
+    void follow(const IGame& game, std::shared_ptr<IPlayer> shooter);
+
+    void reset(int boardSize);
+    void record(int x, int y, bool hit, bool head);
+
+    void onShipPlaced(const Ship& ship) override;
+    void onShotFired(const Cell& cell, GameState gameState) override;
+    void onGameStateChanged(GameState newState) override;
+
+    int getBoardSize() const;
+    int getPlacementCount() const;
+    int getCandidateCount() const;
+    bool isCandidate(int placement) const;
+    Position getHead(int placement) const;
+    Orientation getOrientation(int placement) const;
+    // The placement's cells (y * size + x), head first. Inline, LayoutSampler asks for every try.
+    std::span<const int> getCells(int placement) const { return m_placements[placement].cells; }
+    // Every placement with a part on the cell, candidate or not.
+    std::span<const int> getCovering(int cell) const;
+    // One bit per placement id, set while it is a candidate.
+    const std::vector<std::uint64_t>& getLive() const;
+
+    // Candidates with a part / their head on the cell, indexed y * size + x.
+    const std::vector<std::uint32_t>& getCounts() const;
+    const std::vector<std::uint32_t>& getHeadCounts() const;
+
+private:
+    struct Placement {
+        int head{ 0 };
+        Orientation orientation{ Orientation::Up };
+        int cells[10]{};
+    };
+
+    void build(int boardSize);
+    void drop(int placement);
+
+    int m_size{ 0 };
+    std::vector<Placement> m_placements;
+    // placements covering each cell, coverStart[cell] .. coverStart[cell + 1]
+    std::vector<int> m_coverStart;
+    std::vector<int> m_cover;
+    // counts with nothing shot yet, copied back on reset
+    std::vector<std::uint32_t> m_initialCounts;
+    std::vector<std::uint32_t> m_initialHeadCounts;
+
+    std::vector<std::uint64_t> m_live;
+    std::vector<std::uint8_t> m_shot;
+    std::vector<std::uint32_t> m_counts;
+    std::vector<std::uint32_t> m_headCounts;
+    int m_candidates{ 0 };
+
+    const IGame* m_game{ nullptr };
+    std::weak_ptr<IPlayer> m_shooter;
+};
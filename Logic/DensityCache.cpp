@@ -0,0 +1,58 @@
+#include "DensityCache.h"
+#include "Symmetry.h"
+#include "Zobrist.h"
+
+std::size_t DensityCache::KeyHash::operator()(const LayoutObservation& observation) const
+{
+    std::uint64_t hash = 0;
+    observation.hits.forEachBit([&](int cell) { hash ^= Zobrist::key(Zobrist::HitCell, cell); });
+    observation.misses.forEachBit([&](int cell) { hash ^= Zobrist::key(Zobrist::MissCell, cell); });
+    observation.heads.forEachBit([&](int cell) { hash ^= Zobrist::key(Zobrist::HeadKill, cell); });
+    return static_cast<std::size_t>(hash);
+}
+
+bool DensityCache::KeyEqual::operator()(const LayoutObservation& a, const LayoutObservation& b) const
+{
+    return a.hits == b.hits && a.misses == b.misses && a.heads == b.heads;
+}
+
+DensityCache::DensityCache(std::size_t capacity)
+    : m_capacity(capacity)
+{
+}
+
+bool DensityCache::find(const LayoutObservation& observation, LayoutDensity& density) const
+{
+    LayoutObservation canonical;
+    const int symmetry = Symmetry::canonicalize(observation, canonical);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto entry = m_entries.find(canonical);
+    if (entry == m_entries.end())
+        return false;
+    density = Symmetry::apply(entry->second, Symmetry::INVERSE[symmetry]);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void DensityCache::insert(const LayoutObservation& observation, const LayoutDensity& density)
+{
+    LayoutObservation canonical;
+    const int symmetry = Symmetry::canonicalize(observation, canonical);
+    LayoutDensity stored = Symmetry::apply(density, symmetry);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.size() < m_capacity)
+        m_entries.emplace(canonical, std::move(stored));
+}
+
+std::size_t DensityCache::getSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+std::uint64_t DensityCache::getHitCount() const
+{
+    return m_hits.load(std::memory_order_relaxed);
+}
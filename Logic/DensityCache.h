@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "LayoutEnumerator.h"
+
+// Heatmaps of positions already counted, shared by any number of shooters on any threads. A
+// position is kept under its canonical image (Symmetry::canonicalize), so it and its seven
+// mirrors share one entry and a lookup mirrors the tallies back. Meant for the opening and
+// early shots, which every game goes through; one cache per plane count.
+class DensityCache {
+public:
+    explicit DensityCache(std::size_t capacity = 4096);
+
+    // True, with the tallies of the observation, if it or one of its mirrors was inserted.
+    bool find(const LayoutObservation& observation, LayoutDensity& density) const;
+    // Keeps the tallies; once the cache holds capacity positions nothing more is added.
+    void insert(const LayoutObservation& observation, const LayoutDensity& density);
+
+    std::size_t getSize() const;
+    std::uint64_t getHitCount() const;
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const LayoutObservation& observation) const;
+    };
+    struct KeyEqual {
+        bool operator()(const LayoutObservation& a, const LayoutObservation& b) const;
+    };
+
+    std::size_t m_capacity;
+    mutable std::mutex m_mutex;
+    std::unordered_map<LayoutObservation, LayoutDensity, KeyHash, KeyEqual> m_entries;
+    mutable std::atomic<std::uint64_t> m_hits{ 0 };
+};
@@ -0,0 +1,120 @@
+#include "DensityShooter.h"
+#include <algorithm>
+
+DensityShooter::DensityShooter(int planeCount, Aim aim)
+    : m_enumerator(planeCount), m_aim(aim)
+{
+}
+
+DensityShooter::DensityShooter(std::shared_ptr<const LayoutDatabase> database, Aim aim)
+    : m_enumerator(database ? database->getPlaneCount() : 0), m_database(std::move(database)), m_aim(aim)
+{
+}
+
+void DensityShooter::reset(int boardSize)
+{
+    m_size = boardSize;
+    m_shot.assign(static_cast<std::size_t>(boardSize) * boardSize, 0);
+    m_observation = LayoutObservation();
+    m_density = LayoutDensity();
+    if (boardSize == PlacementTable::BOARD_SIZE) {
+        m_sampler.reset();
+        m_tracker.reset(boardSize);
+    }
+    else if (m_sampler && m_sampler->getBoardSize() == boardSize)
+        m_sampler->reset();
+    else
+        m_sampler = std::make_unique<LayoutSampler>(boardSize, m_enumerator.getPlaneCount());
+}
+
+template <typename Tally>
+int DensityShooter::pickCell(const Tally& primary, const Tally& occupied, SplitMix64& rng) const
+{
+    int best = -1;
+    int ties = 0;
+    for (int cell = 0; cell < static_cast<int>(m_shot.size()); ++cell) {
+        if (m_shot[cell])
+            continue;
+        if (best >= 0 && (primary[cell] < primary[best]
+            || (primary[cell] == primary[best] && occupied[cell] < occupied[best])))
+            continue;
+        if (best >= 0 && primary[cell] == primary[best] && occupied[cell] == occupied[best]) {
+            if (rng.nextInt(++ties) != 0)
+                continue;
+        }
+        else {
+            ties = 1;
+        }
+        best = cell;
+    }
+    return best;
+}
+
+void DensityShooter::countDensity()
+{
+    if (m_cache && m_cache->find(m_observation, m_density))
+        return;
+    if (m_database) {
+        m_database->countDensity(m_observation, m_density);
+    }
+    else {
+        LayoutEnumerator::PlacementSet allowed;
+        const auto& live = m_tracker.getLive();
+        std::copy(live.begin(), live.end(), allowed.words);
+        m_enumerator.countDensity(m_observation, allowed, m_density);
+    }
+    if (m_cache)
+        m_cache->insert(m_observation, m_density);
+}
+
+Position DensityShooter::nextShot(SplitMix64& rng)
+{
+    int best;
+    if (m_sampler) {
+        SamplerConfig config = m_sampling;
+        config.seed = rng.next();
+        SampleHeatmap heatmap = m_sampler->sample(config);
+        best = m_aim == Aim::Heads ? pickCell(heatmap.heads, heatmap.occupied, rng) : pickCell(heatmap.occupied, heatmap.occupied, rng);
+    }
+    else {
+        countDensity();
+        best = m_aim == Aim::Heads ? pickCell(m_density.heads, m_density.occupied, rng) : pickCell(m_density.occupied, m_density.occupied, rng);
+    }
+
+    if (best < 0)
+        return Position(-1, -1);
+    m_shot[best] = 1;
+    return Position(best % m_size, best / m_size);
+}
+
+void DensityShooter::onShotResult(const Cell& cell)
+{
+    const int x = cell.position.m_x;
+    const int y = cell.position.m_y;
+    if (x < 0 || x >= m_size || y < 0 || y >= m_size)
+        return;
+
+    const bool hit = cell.state == CellState::Hit;
+    m_shot[y * m_size + x] = 1;
+    if (m_sampler)
+        m_sampler->record(x, y, hit, cell.isHead);
+    else {
+        m_observation.record(y * m_size + x, hit, cell.isHead);
+        m_tracker.record(x, y, hit, cell.isHead);
+    }
+}
+
+void DensityShooter::setSampling(const SamplerConfig& config)
+{
+    m_sampling = config;
+}
+
+void DensityShooter::setCache(std::shared_ptr<DensityCache> cache)
+{
+    m_cache = std::move(cache);
+}
+
+const LayoutDensity& DensityShooter::getDensity() const
+{
+    return m_density;
+}
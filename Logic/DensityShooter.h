@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "CandidateTracker.h"
+#include "DensityCache.h"
+#include "IShootingStrategy.h"
+#include "LayoutDatabase.h"
+#include "LayoutEnumerator.h"
+#include "LayoutSampler.h"
+
+// Fires at the open cell where the most layouts that still fit what it has seen have a live
+// plane (a head hit destroys the whole plane), or with Aim::Heads at the cell that is most
+// often a plane head (occupancy breaks ties). The plane count has to match the game's getMaxShips(). On the classic 10x10 board every layout is
+// counted; given an open LayoutDatabase, they are filtered from it instead and the plane count
+// is the database's. Other board sizes use a LayoutSampler heatmap within the sampling budget.
+class DensityShooter : public IShootingStrategy {
+public:
+    enum class Aim {
+        Parts,
+        Heads
+    };
+
+    explicit DensityShooter(int planeCount = 3, Aim aim = Aim::Parts);
+    explicit DensityShooter(std::shared_ptr<const LayoutDatabase> database, Aim aim = Aim::Parts);
+
+    void reset(int boardSize) override;
+    Position nextShot(SplitMix64& rng) override;
+    void onShotResult(const Cell& cell) override;
+
+    // Budget and threads for boards that are sampled; the seed is drawn per shot.
+    void setSampling(const SamplerConfig& config);
+    // Heatmaps shared with other shooters of the same plane count on the classic board.
+    void setCache(std::shared_ptr<DensityCache> cache);
+    const LayoutDensity& getDensity() const;
+
+private:
+    // m_density for m_observation, from the cache when it has it
+    void countDensity();
+    // best open cell; equal cells are picked uniformly at random
+    template <typename Tally>
+    int pickCell(const Tally& primary, const Tally& occupied, SplitMix64& rng) const;
+
+    LayoutEnumerator m_enumerator;
+    std::shared_ptr<const LayoutDatabase> m_database;
+    std::shared_ptr<DensityCache> m_cache;
+    Aim m_aim;
+    int m_size{ 0 };
+    std::unique_ptr<LayoutSampler> m_sampler;
+    SamplerConfig m_sampling;
+    LayoutObservation m_observation;
+    // placements still allowed on the classic board, pruned shot by shot
+    CandidateTracker m_tracker;
+    std::vector<std::uint8_t> m_shot;
+    LayoutDensity m_density;
+};
@@ -0,0 +1,193 @@
+#include "DynamicBoard.h"
+#include <algorithm>
+#include "PlacementTable.h"
+
+DynamicBoard::DynamicBoard(int size)
+    : m_size(size),
+    m_shipCells(size * size), m_headCells(size * size),
+    m_hitCells(size * size), m_missCells(size * size),
+    m_states(size * size, CellState::Empty),
+    m_planeAt(size * size, -1), m_partAt(size * size, -1)
+{
+}
+
+bool DynamicBoard::placeShip(const Ship& plane)
+{
+    if (!canPlaceShip(plane))
+        return false;
+
+    const auto planeId = static_cast<std::int16_t>(m_ships.size());
+    const auto parts = plane.getParts();
+    for (int i = 0; i < Ship::PART_COUNT; ++i) {
+        int cell = index(parts[i].getPosition());
+        m_shipCells.set(cell);
+        m_states[cell] = CellState::Ship;
+        m_planeAt[cell] = planeId;
+        m_partAt[cell] = static_cast<std::int8_t>(i);
+    }
+    m_headCells.set(index(plane.getHead()));
+
+    m_ships.push_back(plane);
+    return true;
+}
+
+bool DynamicBoard::receiveShot(const Position& position)
+{
+    if (!isValid(position))
+        return false;
+
+    int cell = index(position);
+    if (m_hitCells.test(cell) || m_missCells.test(cell))
+        return false;
+
+    if (!m_shipCells.test(cell))
+    {
+        m_missCells.set(cell);
+        m_states[cell] = CellState::Miss;
+        return false;
+    }
+
+    m_hitCells.set(cell);
+    m_states[cell] = CellState::Hit;
+
+    Ship& ship = m_ships[m_planeAt[cell]];
+    bool wasSunk = ship.isSunk();
+    ship.hitPart(m_partAt[cell]);
+    if (!wasSunk && ship.isSunk())
+        ++m_sunkCount;
+
+    return true;
+}
+
+ShotBatchResult DynamicBoard::receiveShots(std::span<const Position> positions)
+{
+    ShotBatchResult result;
+    const auto count = std::min(positions.size(), ShotBatchResult::MAX_SHOTS);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Position& position = positions[i];
+        if (!isValid(position))
+            continue;
+
+        const int cell = index(position);
+        const std::uint64_t bit = std::uint64_t{ 1 } << i;
+        if (m_hitCells.test(cell) || m_missCells.test(cell))
+            continue;
+
+        if (!m_shipCells.test(cell))
+        {
+            m_missCells.set(cell);
+            m_states[cell] = CellState::Miss;
+            result.misses |= bit;
+            continue;
+        }
+
+        m_hitCells.set(cell);
+        m_states[cell] = CellState::Hit;
+        result.hits |= bit;
+        if (m_headCells.test(cell))
+            result.headKills |= bit;
+
+        const int plane = m_planeAt[cell];
+        Ship& ship = m_ships[plane];
+        const bool wasSunk = ship.isSunk();
+        ship.hitPart(m_partAt[cell]);
+        if (!wasSunk && ship.isSunk())
+        {
+            ++m_sunkCount;
+            if (plane < ShotBatchResult::MAX_PLANES)
+                result.destroyedPlanes |= std::uint64_t{ 1 } << plane;
+        }
+    }
+
+    result.resolved = static_cast<int>(count);
+    return result;
+}
+
+int DynamicBoard::getShipsCount() const {
+    return static_cast<int>(m_ships.size());
+}
+
+int DynamicBoard::getSize() const {
+    return m_size;
+}
+
+const std::vector<Ship>& DynamicBoard::getShips() const
+{
+    return m_ships;
+}
+
+CellState DynamicBoard::getCellState(const Position& position) const
+{
+    if (!isValid(position))
+        return CellState::Empty;
+
+    return m_states[index(position)];
+}
+
+void DynamicBoard::resetBoard()
+{
+    m_shipCells.clear();
+    m_headCells.clear();
+    m_hitCells.clear();
+    m_missCells.clear();
+    std::fill(m_states.begin(), m_states.end(), CellState::Empty);
+    std::fill(m_planeAt.begin(), m_planeAt.end(), -1);
+    std::fill(m_partAt.begin(), m_partAt.end(), -1);
+    m_ships.clear();
+    m_sunkCount = 0;
+}
+
+bool DynamicBoard::allShipsSunk() const
+{
+    return m_sunkCount == static_cast<int>(m_ships.size());
+}
+
+Cell DynamicBoard::getCellInfo(const Position& p) const
+{
+    if (!isValid(p)) return Cell{ p, CellState::Empty, false };
+    return Cell{ p, getCellState(p), m_headCells.test(index(p)) };
+}
+
+BoardView DynamicBoard::getView() const
+{
+    return BoardView{ m_size, m_shipCells.wordCount(), m_shipCells.data(), m_headCells.data(),
+        m_hitCells.data(), m_missCells.data(), m_states.data() };
+}
+
+// BoardSnapshot is laid out for the classic board only.
+bool DynamicBoard::saveSnapshot(BoardSnapshot&) const
+{
+    return false;
+}
+
+bool DynamicBoard::loadSnapshot(const BoardSnapshot&)
+{
+    return false;
+}
+
+bool DynamicBoard::canPlaceShip(const Ship& ship) const
+{
+    return canPlaceShipAt(ship.getHead(), ship.getOrientation());
+}
+
+bool DynamicBoard::canPlaceShipAt(const Position& head, Orientation orientation) const
+{
+    for (const auto& offset : PlacementTable::OFFSETS[static_cast<int>(orientation)]) {
+        Position part(head.m_x + offset.x, head.m_y + offset.y);
+        if (!isValid(part) || m_shipCells.test(index(part)))
+            return false;
+    }
+    return true;
+}
+
+bool DynamicBoard::isValid(const Position& position) const
+{
+    return position.m_x >= 0 && position.m_x < m_size && position.m_y >= 0 && position.m_y < m_size;
+}
+
+int DynamicBoard::index(const Position& position) const
+{
+    return position.m_y * m_size + position.m_x;
+}
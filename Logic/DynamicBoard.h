@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "IBoard.h"
+#include "BitGrid.h"
+#include "Ship.h"
+#include "Position.h"
+#include "CellState.h"
+#include "Cell.h"
+
+// IBoard for arenas larger than the classic 10x10, sized at runtime and backed by bit grids.
+class DynamicBoard final : public IBoard {
+private:
+    int m_size;
+    BitGrid m_shipCells;
+    BitGrid m_headCells;
+    BitGrid m_hitCells;
+    BitGrid m_missCells;
+    std::vector<CellState> m_states;
+    // index in m_ships and part index of the plane covering each cell, -1 when empty
+    std::vector<std::int16_t> m_planeAt;
+    std::vector<std::int8_t> m_partAt;
+    std::vector<Ship> m_ships;
+    int m_sunkCount{ 0 };
+
+public:
+    // size must be positive and small enough for size * size cells; GameFactory keeps it in range.
+    explicit DynamicBoard(int size);
+
+    bool receiveShot(const Position& position) override;
+    ShotBatchResult receiveShots(std::span<const Position> positions) override;
+    void resetBoard() override;
+    CellState getCellState(const Position& position) const override;
+    int getShipsCount() const override;
+    int getSize() const override;
+    const std::vector<Ship>& getShips() const override;
+
+    bool placeShip(const Ship& plane) override;
+
+    bool allShipsSunk() const override;
+
+    Cell getCellInfo(const Position& p) const override;
+    BoardView getView() const override;
+    bool saveSnapshot(BoardSnapshot& snapshot) const override;
+    bool loadSnapshot(const BoardSnapshot& snapshot) override;
+    bool canPlaceShip(const Ship& ship) const override;
+    bool canPlaceShipAt(const Position& head, Orientation orientation) const override;
+
+private:
+    bool isValid(const Position& position) const;
+    int index(const Position& position) const;
+};
@@ -0,0 +1,82 @@
+#include "EventBus.h"
+
+namespace {
+    std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t power = 1;
+        while (power < value)
+            power <<= 1;
+        return power;
+    }
+}
+
+EventBus::EventBus(std::size_t capacity)
+    : m_ring(roundUpToPowerOfTwo(capacity == 0 ? 1 : capacity)),
+    m_indexMask(m_ring.size() - 1)
+{
+}
+
+void EventBus::publish(GameEvent event)
+{
+    event.sequence = m_published;
+
+    switch (event.type) {
+    case GameEventType::ShipPlaced:
+        ++m_totals.shipsPlaced;
+        break;
+    case GameEventType::ShotFired:
+        ++m_totals.shots;
+        if (event.cellState == CellState::Hit)
+            ++m_totals.hits;
+        if (event.isHead)
+            ++m_totals.headHits;
+        break;
+    case GameEventType::StateChanged:
+        ++m_totals.stateChanges;
+        break;
+    case GameEventType::TurnSwitched:
+        break;
+    }
+    m_totals.lastState = event.state;
+
+    m_ring[m_published & m_indexMask] = event;
+    ++m_published;
+}
+
+EventCursor EventBus::subscribe(GameEventMask mask) const
+{
+    EventCursor cursor;
+    cursor.next = m_published;
+    cursor.mask = mask;
+    return cursor;
+}
+
+std::size_t EventBus::pending(const EventCursor& cursor) const
+{
+    std::uint64_t behind = m_published - cursor.next;
+    return static_cast<std::size_t>(behind < m_ring.size() ? behind : m_ring.size());
+}
+
+std::uint64_t EventBus::getPublishedCount() const
+{
+    return m_published;
+}
+
+std::size_t EventBus::getCapacity() const
+{
+    return m_ring.size();
+}
+
+const EventTotals& EventBus::getTotals() const
+{
+    return m_totals;
+}
+
+void EventBus::skipOverwritten(EventCursor& cursor) const
+{
+    if (m_published - cursor.next > m_ring.size()) {
+        std::uint64_t oldest = m_published - m_ring.size();
+        cursor.dropped += oldest - cursor.next;
+        cursor.next = oldest;
+    }
+}
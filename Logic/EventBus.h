@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "GameEvent.h"
+
+// Where a subscriber is in the event stream and which events it wants.
+struct EventCursor {
+    std::uint64_t next{ 0 };
+    GameEventMask mask{ ALL_GAME_EVENTS };
+    std::uint64_t dropped{ 0 };         // events overwritten before this cursor got to them
+};
+
+// Running totals kept on publish, for subscribers that only need a summary.
+struct EventTotals {
+    std::uint64_t shipsPlaced{ 0 };
+    std::uint64_t shots{ 0 };
+    std::uint64_t hits{ 0 };
+    std::uint64_t headHits{ 0 };
+    std::uint64_t stateChanges{ 0 };
+    GameState lastState{ GameState::PlacingShips };
+};
+
+// Preallocated power-of-two ring of GameEvents. Publishing is a store and two increments;
+// subscribers keep their own cursor and drain in batches when it suits them. When a
+// subscriber falls more than the capacity behind, the oldest events are skipped and counted.
+// Not thread safe: publish and drain from the thread that runs the game.
+class EventBus {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+    explicit EventBus(std::size_t capacity = DEFAULT_CAPACITY);
+
+    void publish(GameEvent event);
+
+    // Cursor that sees only events published from now on.
+    EventCursor subscribe(GameEventMask mask = ALL_GAME_EVENTS) const;
+
+    // Calls fn(const GameEvent&) for up to maxEvents matching events and moves the cursor past them.
+    template <typename Fn>
+    std::size_t drain(EventCursor& cursor, Fn&& fn, std::size_t maxEvents = std::numeric_limits<std::size_t>::max()) const
+    {
+        skipOverwritten(cursor);
+
+        std::size_t delivered = 0;
+        while (cursor.next < m_published && delivered < maxEvents) {
+            const GameEvent& event = m_ring[cursor.next & m_indexMask];
+            ++cursor.next;
+            if (cursor.mask & eventMask(event.type)) {
+                fn(event);
+                ++delivered;
+            }
+        }
+        return delivered;
+    }
+
+    std::size_t pending(const EventCursor& cursor) const;
+    std::uint64_t getPublishedCount() const;
+    std::size_t getCapacity() const;
+    const EventTotals& getTotals() const;
+
+private:
+    void skipOverwritten(EventCursor& cursor) const;
+
+    std::vector<GameEvent> m_ring;
+    std::uint64_t m_indexMask;
+    std::uint64_t m_published{ 0 };
+    EventTotals m_totals;
+};
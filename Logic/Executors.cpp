@@ -0,0 +1,82 @@
+#include "Executors.h"
+#include <algorithm>
+
+void ManualExecutor::post(std::coroutine_handle<> handle)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(handle);
+}
+
+std::size_t ManualExecutor::runAll()
+{
+    std::size_t count = 0;
+    for (;;) {
+        std::coroutine_handle<> handle;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_queue.empty())
+                return count;
+            handle = m_queue.front();
+            m_queue.pop_front();
+        }
+        handle.resume();
+        ++count;
+    }
+}
+
+std::size_t ManualExecutor::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+ThreadPoolExecutor::ThreadPoolExecutor(int threads)
+{
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    m_threads.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        m_threads.emplace_back(&ThreadPoolExecutor::run, this);
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void ThreadPoolExecutor::post(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(handle);
+    }
+    m_wakeup.notify_one();
+}
+
+int ThreadPoolExecutor::getThreadCount() const
+{
+    return static_cast<int>(m_threads.size());
+}
+
+void ThreadPoolExecutor::run()
+{
+    for (;;) {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping)
+                return;
+            handle = m_queue.front();
+            m_queue.pop_front();
+        }
+        handle.resume();
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "IExecutor.h"
+
+// Queues handles until the owner runs them, e.g. from a UI timer or a test.
+class ManualExecutor : public IExecutor {
+public:
+    void post(std::coroutine_handle<> handle) override;
+
+    // Resumes everything queued, including what gets posted meanwhile; returns how many.
+    std::size_t runAll();
+    std::size_t pending() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::deque<std::coroutine_handle<>> m_queue;
+};
+
+// A few threads sharing one queue. Matches only hold a thread while they are actually moving,
+// so thousands of them can wait for players on a handful of threads.
+class ThreadPoolExecutor : public IExecutor {
+public:
+    // 0 = one thread per core
+    explicit ThreadPoolExecutor(int threads = 0);
+    // Stops the threads; handles still queued are not resumed.
+    ~ThreadPoolExecutor() override;
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    void post(std::coroutine_handle<> handle) override;
+    int getThreadCount() const;
+
+private:
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::deque<std::coroutine_handle<>> m_queue;
+    bool m_stopping{ false };
+    std::vector<std::thread> m_threads;
+};
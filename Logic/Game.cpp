@@ -6,8 +6,9 @@
 #include "Player.h"
 
 Game::Game(std::shared_ptr<IPlayer> player1, std::shared_ptr<IPlayer> player2, int maxShips)
-    : m_player1(player1), m_player2(player2), m_currentPlayer(player1),
-    m_state(GameState::PlacingShips), m_maxShips(maxShips)
+    : m_player1(player1), m_player2(player2),
+    m_core(BoardHandle(player1 ? player1->getBoard() : nullptr),
+        BoardHandle(player2 ? player2->getBoard() : nullptr), maxShips)
 {
 }
 
@@ -32,6 +33,16 @@ void Game::removeListener(std::shared_ptr<IGameListener> listener) {
 }
 
 void Game::notifyShipPlaced(const Ship& ship) {
+    GameEvent event;
+    event.type = GameEventType::ShipPlaced;
+    event.player = static_cast<std::uint8_t>(m_core.getTurn());
+    event.turnNumber = m_core.getTurnNumber();
+    event.x = static_cast<std::int16_t>(ship.getHead().m_x);
+    event.y = static_cast<std::int16_t>(ship.getHead().m_y);
+    event.orientation = ship.getOrientation();
+    event.state = m_core.getState();
+    m_events.publish(event);
+
     for (auto iterator = m_listeners.begin(); iterator != m_listeners.end();) {
         if (auto listener = iterator->lock()) {
             listener->onShipPlaced(ship);
@@ -44,9 +55,20 @@ void Game::notifyShipPlaced(const Ship& ship) {
 }
 
 void Game::notifyShotFired(const Cell& cell) {
+    GameEvent event;
+    event.type = GameEventType::ShotFired;
+    event.player = static_cast<std::uint8_t>(m_core.getTurn());
+    event.turnNumber = m_core.getTurnNumber();
+    event.x = static_cast<std::int16_t>(cell.position.m_x);
+    event.y = static_cast<std::int16_t>(cell.position.m_y);
+    event.cellState = cell.state;
+    event.isHead = cell.isHead;
+    event.state = m_core.getState();
+    m_events.publish(event);
+
     for (auto iterator = m_listeners.begin(); iterator != m_listeners.end();) {
         if (auto listener = iterator->lock()) {
-            listener->onShotFired(cell, m_state);
+            listener->onShotFired(cell, m_core.getState());
             ++iterator;
         }
         else {
@@ -56,6 +78,13 @@ void Game::notifyShotFired(const Cell& cell) {
 }
 
 void Game::notifyGameStateChanged(GameState newState) {
+    GameEvent event;
+    event.type = GameEventType::StateChanged;
+    event.player = static_cast<std::uint8_t>(m_core.getTurn());
+    event.turnNumber = m_core.getTurnNumber();
+    event.state = newState;
+    m_events.publish(event);
+
     for (auto iterator = m_listeners.begin(); iterator != m_listeners.end();) {
         if (auto listener = iterator->lock()) {
             listener->onGameStateChanged(newState);
@@ -67,34 +96,26 @@ void Game::notifyGameStateChanged(GameState newState) {
     }
 }
 
+EventBus& Game::getEventBus() {
+    return m_events;
+}
 
 void Game::changeState(GameState newState) {
-	m_state = newState;
+    m_core.setState(newState);
     notifyGameStateChanged(newState);
 }
 
 void Game::startGame() {
-    m_currentPlayer = m_player1;
+    m_core.start();
     changeState(GameState::PlacingShips);
-
-    if (m_player1 && m_player1->getBoard()) {
-        m_player1->getBoard()->resetBoard();
-    }
-
-    if (m_player2 && m_player2->getBoard()) {
-        m_player2->getBoard()->resetBoard();
-    }
 }
 
 bool Game::placeShip(const Position& start, int length, Orientation orientation) {
-    if (auto currentPlayerShared = m_currentPlayer.lock()) {
-        Ship plane(start, orientation);
+    Ship plane(start, orientation);
 
-        if (currentPlayerShared->placeShip(plane)) {
-            notifyShipPlaced(plane);
-
-            return true;
-        }
+    if (m_core.placeShip(plane)) {
+        notifyShipPlaced(plane);
+        return true;
     }
 
     return false;
@@ -103,63 +124,47 @@ bool Game::placeShip(const Position& start, int length, Orientation orientation)
 void Game::shoot(const Position& position) {
     if (isGameOver()) return;
 
-    auto currentShared = m_currentPlayer.lock();
-    if (!currentShared) return;
-
-    auto opponent = (currentShared == m_player1) ? m_player2 : m_player1;
-    if (!opponent) return;
-
-    auto board = opponent->getBoard();
-    if (!board) return;
+    auto result = m_core.resolveShot(position);
+    if (!result.resolved) return;
 
-    bool hit = board->receiveShot(position);
-
-    Cell cell{ position, hit ? CellState::Hit : CellState::Miss };
+    Cell cell{ position, result.hit ? CellState::Hit : CellState::Miss, result.headHit };
     notifyShotFired(cell);
 
-    if (board->allShipsSunk()) {
+    if (result.gameOver) {
         changeState(GameState::GameOver);
     }
     else {
         changeState(GameState::SwitchingTurn);
-        switchTurn();
+        m_core.switchTurn();
     }
 }
 
 
 void Game::switchTurn() {
-    auto currentShared = m_currentPlayer.lock();
-    if (!currentShared) return;
+    bool placementDone = m_core.switchTurn();
 
-    m_currentPlayer = (currentShared == m_player1) ? m_player2 : m_player1;
+    // no listener callback for this one, the bus is enough to replay it
+    GameEvent event;
+    event.type = GameEventType::TurnSwitched;
+    event.player = static_cast<std::uint8_t>(m_core.getTurn());
+    event.turnNumber = m_core.getTurnNumber();
+    event.state = m_core.getState();
+    m_events.publish(event);
 
-    if (m_state == GameState::PlacingShips) {
-        if (m_player1 && m_player2
-            && m_player1->allShipsPlaced(m_maxShips)
-            && m_player2->allShipsPlaced(m_maxShips)) {
-            changeState(GameState::InProgress);
-        }
-    }
+    if (placementDone)
+        notifyGameStateChanged(GameState::InProgress);
 }
 
 bool Game::isGameOver() const {
-    for (auto player : { m_player1, m_player2 }) {
-        if (!player) continue;
-
-        auto board = player->getBoard();
-        if (board && board->allShipsSunk()) {
-            return true;
-        }
-    }
-    return false;
+    return m_core.isGameOver();
 }
 
 GameState Game::getState() const {
-    return m_state;
+    return m_core.getState();
 }
 
 int Game::getMaxShips() const {
-    return m_maxShips;
+    return m_core.getMaxShips();
 }
 
 std::shared_ptr<IPlayer> Game::getPlayer1() const
@@ -174,10 +179,30 @@ std::shared_ptr<IPlayer> Game::getPlayer2() const
 
 std::weak_ptr<IPlayer> Game::getCurrentPlayer() const
 {
-    return m_currentPlayer;
+    return m_core.getTurn() == 0 ? m_player1 : m_player2;
 }
 
 int Game::getGridSize() const
 {
-    return m_currentPlayer.lock()->getBoard()->getSize();
+    return m_core.getBoard(m_core.getTurn()).get()->getSize();
+}
+
+int Game::getCurrentPlayerIndex() const
+{
+    return m_core.getTurn();
+}
+
+void Game::restore(int currentPlayerIndex, GameState state, int maxShips)
+{
+    m_core.restore(currentPlayerIndex, state, maxShips);
+}
+
+bool Game::saveSnapshot(GameSnapshot& snapshot) const
+{
+    return m_core.saveSnapshot(snapshot);
+}
+
+bool Game::loadSnapshot(const GameSnapshot& snapshot)
+{
+    return m_core.loadSnapshot(snapshot);
 }
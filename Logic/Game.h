@@ -4,9 +4,12 @@
 #include "IBoard.h"
 #include "IGameListener.h"
 #include "Orientation.h"
+#include "GameCore.h"
+#include "BoardHandle.h"
 #include <vector>
 #include <memory>
 
+// IGame adapter over GameCore for the UI: keeps the players and the listeners, the rules live in m_core.
 class Game : public IGame {
 public:
     Game(std::shared_ptr<IPlayer> player1, std::shared_ptr<IPlayer> player2, int maxShips=3);
@@ -17,6 +20,7 @@ public:
     void notifyShipPlaced(const Ship& ship) override;
     void notifyShotFired(const Cell& cell) override;
     void notifyGameStateChanged(GameState newState) override;
+    EventBus& getEventBus() override;
 
     void startGame() override;
     bool placeShip(const Position& start, int length = 1, Orientation orientation = Orientation::Up) override;
@@ -29,14 +33,19 @@ public:
     std::shared_ptr<IPlayer> getPlayer2() const override;
     std::weak_ptr<IPlayer> getCurrentPlayer() const override;
     int getGridSize() const override;
+    bool saveSnapshot(GameSnapshot& snapshot) const override;
+    bool loadSnapshot(const GameSnapshot& snapshot) override;
+
+    int getCurrentPlayerIndex() const;
+    // Puts turn, state and plane limit back without notifying listeners (used when decoding a saved game).
+    void restore(int currentPlayerIndex, GameState state, int maxShips);
 
 private:
     std::vector<std::weak_ptr<IGameListener>> m_listeners;
     std::shared_ptr<IPlayer> m_player1;
     std::shared_ptr<IPlayer> m_player2;
-    std::weak_ptr<IPlayer> m_currentPlayer;
-    GameState m_state;
-    int m_maxShips;
+    GameCore<BoardHandle> m_core;
+    EventBus m_events;
 
     void changeState(GameState newState);
 };
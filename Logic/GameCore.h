@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include "GameSnapshot.h"
+#include "GameState.h"
+#include "Position.h"
+#include "Orientation.h"
+#include "Cell.h"
+#include "Ship.h"
+
+// Game rules on two boards held by value. With a final board type every call below is direct,
+// there is no reference counting and shot resolution only looks at the board that was shot at.
+// Game wraps a GameCore for the UI; simulations drive one directly.
+template <typename BoardT>
+class GameCore {
+public:
+    struct ShotResult {
+        bool resolved{ false };         // false when the game was already over
+        bool hit{ false };
+        bool headHit{ false };
+        bool gameOver{ false };
+    };
+
+    GameCore(BoardT first, BoardT second, int maxShips)
+        : m_boards{ std::move(first), std::move(second) }, m_maxShips(maxShips)
+    {
+    }
+
+    template <typename... BoardArgs>
+    explicit GameCore(int maxShips, BoardArgs&&... boardArgs)
+        : m_boards{ BoardT(boardArgs...), BoardT(boardArgs...) }, m_maxShips(maxShips)
+    {
+    }
+
+    void start()
+    {
+        m_turn = 0;
+        m_turnNumber = 0;
+        m_state = GameState::PlacingShips;
+        m_boards[0].resetBoard();
+        m_boards[1].resetBoard();
+    }
+
+    // Places a plane on the board of the player whose turn it is.
+    bool placeShip(const Ship& plane)
+    {
+        BoardT& board = m_boards[m_turn];
+        return board.canPlaceShipAt(plane.getHead(), plane.getOrientation()) && board.placeShip(plane);
+    }
+
+    // Returns true when this switch ended the placement phase.
+    bool switchTurn()
+    {
+        m_turn ^= 1;
+        ++m_turnNumber;
+        if (m_state == GameState::PlacingShips
+            && m_boards[0].getShipsCount() == m_maxShips
+            && m_boards[1].getShipsCount() == m_maxShips) {
+            m_state = GameState::InProgress;
+            return true;
+        }
+        return false;
+    }
+
+    // Fires at the opponent of the current player; game over ends the game, otherwise the turn passes.
+    ShotResult shoot(const Position& position)
+    {
+        ShotResult result = resolveShot(position);
+        if (!result.resolved)
+            return result;
+
+        if (result.gameOver) {
+            m_state = GameState::GameOver;
+        }
+        else {
+            m_state = GameState::SwitchingTurn;
+            m_turn ^= 1;
+            ++m_turnNumber;
+        }
+        return result;
+    }
+
+    // Only the board part of shoot(): state and turn are left to the caller.
+    ShotResult resolveShot(const Position& position)
+    {
+        ShotResult result;
+        if (m_state == GameState::GameOver)
+            return result;
+
+        BoardT& target = m_boards[m_turn ^ 1];
+        result.resolved = true;
+        result.hit = target.receiveShot(position);
+        result.headHit = result.hit && target.getCellInfo(position).isHead;
+        result.gameOver = target.allShipsSunk();
+        return result;
+    }
+
+    bool isGameOver() const
+    {
+        return m_boards[0].allShipsSunk() || m_boards[1].allShipsSunk();
+    }
+
+    // Puts turn, state and plane limit back as they were saved.
+    void restore(int turn, GameState state, int maxShips)
+    {
+        m_turn = turn & 1;
+        m_turnNumber = static_cast<std::uint32_t>(m_turn);
+        m_state = state;
+        m_maxShips = maxShips;
+    }
+
+    // False when a board has no snapshot form (see IBoard::saveSnapshot).
+    bool saveSnapshot(GameSnapshot& snapshot) const
+    {
+        if (!m_boards[0].saveSnapshot(snapshot.boards[0]) || !m_boards[1].saveSnapshot(snapshot.boards[1]))
+            return false;
+
+        snapshot.turnNumber = m_turnNumber;
+        snapshot.turn = static_cast<std::uint8_t>(m_turn);
+        snapshot.maxShips = static_cast<std::uint8_t>(m_maxShips);
+        snapshot.state = m_state;
+        return true;
+    }
+
+    // Both snapshots are checked before either board changes, so a bad one leaves the game as it was.
+    bool loadSnapshot(const GameSnapshot& snapshot)
+    {
+        BitMask128 ships;
+        if (snapshot.turn > 1 || snapshot.state > GameState::GameOver
+            || !snapshotShipMask(snapshot.boards[0], ships) || !snapshotShipMask(snapshot.boards[1], ships))
+            return false;
+        if (!m_boards[0].loadSnapshot(snapshot.boards[0]) || !m_boards[1].loadSnapshot(snapshot.boards[1]))
+            return false;
+
+        m_turn = snapshot.turn;
+        m_turnNumber = snapshot.turnNumber;
+        m_maxShips = snapshot.maxShips;
+        m_state = snapshot.state;
+        return true;
+    }
+
+    void setState(GameState state) { m_state = state; }
+
+    BoardT& getBoard(int player) { return m_boards[player]; }
+    const BoardT& getBoard(int player) const { return m_boards[player]; }
+    int getTurn() const { return m_turn; }
+    // Turn switches since start(), shots included.
+    std::uint32_t getTurnNumber() const { return m_turnNumber; }
+    GameState getState() const { return m_state; }
+    int getMaxShips() const { return m_maxShips; }
+
+private:
+    BoardT m_boards[2];
+    int m_turn{ 0 };
+    std::uint32_t m_turnNumber{ 0 };
+    GameState m_state{ GameState::PlacingShips };
+    int m_maxShips;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include "CellState.h"
+#include "GameState.h"
+#include "Orientation.h"
+
+enum class GameEventType : std::uint8_t {
+    ShipPlaced,
+    ShotFired,
+    StateChanged,
+    TurnSwitched        // an explicit switchTurn(); the turn also passes after every shot
+};
+
+// One bit per GameEventType, for subscriber filters.
+using GameEventMask = std::uint32_t;
+
+constexpr GameEventMask eventMask(GameEventType type)
+{
+    return GameEventMask{ 1 } << static_cast<int>(type);
+}
+
+inline constexpr GameEventMask ALL_GAME_EVENTS = eventMask(GameEventType::ShipPlaced)
+    | eventMask(GameEventType::ShotFired) | eventMask(GameEventType::StateChanged)
+    | eventMask(GameEventType::TurnSwitched);
+
+struct GameEvent {
+    std::uint64_t sequence{ 0 };        // set by EventBus::publish, starts at 0
+    GameEventType type{ GameEventType::StateChanged };
+    std::uint8_t player{ 0 };           // who placed / who fired / whose turn it is
+    std::uint32_t turnNumber{ 0 };      // turn switches since the game started
+    std::int16_t x{ 0 };                // plane head or shot cell
+    std::int16_t y{ 0 };
+    Orientation orientation{ Orientation::Up };   // ShipPlaced
+    CellState cellState{ CellState::Empty };      // ShotFired: Hit or Miss
+    bool isHead{ false };                         // ShotFired
+    GameState state{ GameState::PlacingShips };   // state after the event
+};
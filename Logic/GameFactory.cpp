@@ -1,23 +1,43 @@
 #include "GameFactory.h"
 #include "Game.h"
 #include "Board.h"
+#include "DynamicBoard.h"
 #include "Player.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 
+static_assert(GameFactory::CLASSIC_BOARD_SIZE == Board::SIZE, "classic games use the fixed-size Board");
+
 GameFactory::GameFactory(const std::string& player1Name,
-    const std::string& player2Name)
-    : m_player1Name(player1Name), m_player2Name(player2Name)
+    const std::string& player2Name, int boardSize, int maxShips)
+    : m_player1Name(player1Name), m_player2Name(player2Name),
+    m_boardSize(std::clamp(boardSize, MIN_BOARD_SIZE, MAX_BOARD_SIZE)), m_maxShips(maxShips)
 {
 }
 
 std::unique_ptr<IGame> GameFactory::create()
 {
-    auto board1 = std::make_shared<Board>();
-    auto board2 = std::make_shared<Board>();
+    auto board1 = createBoard();
+    auto board2 = createBoard();
 
     auto p1 = std::make_shared<Player>(m_player1Name, board1);
     auto p2 = std::make_shared<Player>(m_player2Name, board2);
 
-    return std::make_unique<Game>(p1, p2);
-}
\ No newline at end of file
+    return std::make_unique<Game>(p1, p2, m_maxShips);
+}
+
+std::unique_ptr<IGame> GameFactory::create(const GameSnapshot& snapshot)
+{
+    auto game = create();
+    if (!game->loadSnapshot(snapshot))
+        return nullptr;
+    return game;
+}
+
+std::shared_ptr<IBoard> GameFactory::createBoard() const
+{
+    if (m_boardSize == Board::SIZE)
+        return std::make_shared<Board>();
+    return std::make_shared<DynamicBoard>(m_boardSize);
+}
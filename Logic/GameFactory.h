@@ -1,18 +1,34 @@
 #pragma once
 #include "IGameFactory.h"
+#include "IBoard.h"
 #include <memory>
 #include <string>
 
 class GameFactory : public IGameFactory
 {
 public:
+    static constexpr int CLASSIC_BOARD_SIZE = 10;
+    static constexpr int CLASSIC_MAX_SHIPS = 3;
+    // A plane needs a 5x5 board; match logs and the protocol store the size in one byte.
+    static constexpr int MIN_BOARD_SIZE = 5;
+    static constexpr int MAX_BOARD_SIZE = 255;
+
+    // boardSize is clamped to MIN_BOARD_SIZE..MAX_BOARD_SIZE.
+
     GameFactory(const std::string& player1Name = "Player1",
-        const std::string& player2Name = "Player2");
+        const std::string& player2Name = "Player2",
+        int boardSize = CLASSIC_BOARD_SIZE,
+        int maxShips = CLASSIC_MAX_SHIPS);
 
     std::unique_ptr<IGame> create() override;
+    // Fresh game put into the snapshot's position; nullptr when the snapshot does not load.
+    std::unique_ptr<IGame> create(const GameSnapshot& snapshot);
 
 private:
+    std::shared_ptr<IBoard> createBoard() const;
+
     std::string m_player1Name;
     std::string m_player2Name;
+    int m_boardSize;
+    int m_maxShips;
 };
-
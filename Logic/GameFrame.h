@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BoardView.h"
+#include "CellState.h"
+#include "GameState.h"
+
+// Copy of one board, owned by the frame so the UI can read it while the logic thread keeps playing.
+struct BoardFrame {
+    int size{ 0 };
+    int wordCount{ 0 };
+    int shipCount{ 0 };
+    std::vector<std::uint64_t> ships;
+    std::vector<std::uint64_t> heads;
+    std::vector<std::uint64_t> hits;
+    std::vector<std::uint64_t> misses;
+    std::vector<CellState> states;
+
+    void capture(const BoardView& source, int placed)
+    {
+        size = source.size;
+        wordCount = source.wordCount;
+        shipCount = placed;
+        ships.assign(source.ships, source.ships + wordCount);
+        heads.assign(source.heads, source.heads + wordCount);
+        hits.assign(source.hits, source.hits + wordCount);
+        misses.assign(source.misses, source.misses + wordCount);
+        states.assign(source.states, source.states + size * size);
+    }
+
+    // Valid until the frame is captured again.
+    BoardView view() const
+    {
+        if (states.empty())
+            return BoardView{};
+        return BoardView{ size, wordCount, ships.data(), heads.data(), hits.data(), misses.data(), states.data() };
+    }
+};
+
+// Everything the UI draws, as of the last command the logic thread finished.
+struct GameFrame {
+    std::uint64_t eventCount{ 0 };      // events published by the game so far
+    GameState state{ GameState::PlacingShips };
+    int turn{ 0 };
+    BoardFrame boards[2];
+};
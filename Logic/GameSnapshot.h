@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "BitMask.h"
+#include "GameState.h"
+#include "PlacementTable.h"
+
+// Complete state of a classic 10x10 board: the planes as PlacementTable ids, in placement order,
+// and the cells shot at. Cell states, plane damage and hashes all follow from these.
+struct BoardSnapshot {
+    static constexpr int MAX_PLANES = 10;
+
+    BitMask128 hits;
+    BitMask128 misses;
+    std::uint8_t planeCount{ 0 };
+    std::uint8_t placements[MAX_PLANES]{};
+};
+
+// Ship cells of the snapshot's planes. False when a placement id is out of range, planes overlap
+// or the shots do not fit the layout (outside the board, a miss on a plane, a cell both hit and missed).
+inline bool snapshotShipMask(const BoardSnapshot& snapshot, BitMask128& ships)
+{
+    if (snapshot.planeCount > BoardSnapshot::MAX_PLANES)
+        return false;
+
+    ships = {};
+    for (int i = 0; i < snapshot.planeCount; ++i) {
+        if (snapshot.placements[i] >= PlacementTable::COUNT)
+            return false;
+        const BitMask128& mask = PlacementTable::PLACEMENTS[snapshot.placements[i]].mask;
+        if ((mask & ships).any())
+            return false;
+        ships |= mask;
+    }
+
+    const BitMask128 shots = snapshot.hits | snapshot.misses;
+    return !(shots.words[1] >> (PlacementTable::CELL_COUNT - 64))
+        && (snapshot.hits & snapshot.misses).none()
+        && (snapshot.hits & ~ships).none()
+        && (snapshot.misses & ships).none();
+}
+
+// Both boards plus turn, state and plane limit. About 100 bytes with no pointers, so tree search
+// and rollouts can keep and copy millions of them; IGame::loadSnapshot puts one back into a game.
+struct GameSnapshot {
+    BoardSnapshot boards[2];
+    std::uint32_t turnNumber{ 0 };
+    std::uint8_t turn{ 0 };
+    std::uint8_t maxShips{ 0 };
+    GameState state{ GameState::PlacingShips };
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>, "snapshots are copied as raw bytes");
@@ -0,0 +1,224 @@
+#include "GameWorker.h"
+#include "Ship.h"
+
+GameWorker::GameWorker(std::unique_ptr<IGame> game)
+    : m_game(std::move(game)),
+    m_gridSize(m_game->getGridSize()),
+    m_maxShips(m_game->getMaxShips()),
+    m_cursor(m_game->getEventBus().subscribe())
+{
+}
+
+GameWorker::~GameWorker()
+{
+    stop();
+}
+
+void GameWorker::setBot(int player, std::unique_ptr<IPlacementStrategy> placement,
+    std::unique_ptr<IShootingStrategy> shooter, std::uint64_t seed)
+{
+    if (m_running || player < 0 || player > 1)
+        return;
+
+    auto bot = std::make_unique<Bot>();
+    bot->placement = std::move(placement);
+    bot->shooter = std::move(shooter);
+    bot->rng = SplitMix64(seed);
+    m_bots[player] = std::move(bot);
+}
+
+void GameWorker::start()
+{
+    if (m_running.exchange(true))
+        return;
+    m_thread = std::thread(&GameWorker::run, this);
+}
+
+void GameWorker::stop()
+{
+    if (!m_running.exchange(false))
+        return;
+    wake();
+    m_thread.join();
+}
+
+bool GameWorker::post(const GameCommand& command)
+{
+    if (!m_commands.tryPush(command))
+        return false;
+    wake();
+    return true;
+}
+
+bool GameWorker::updateFrame()
+{
+    return m_frames.update();
+}
+
+const GameFrame& GameWorker::getFrame() const
+{
+    return m_frames.front();
+}
+
+int GameWorker::getGridSize() const
+{
+    return m_gridSize;
+}
+
+int GameWorker::getMaxShips() const
+{
+    return m_maxShips;
+}
+
+void GameWorker::run()
+{
+    publishFrame();
+
+    while (m_running.load(std::memory_order_acquire)) {
+        const std::uint32_t seen = m_wakeups.load(std::memory_order_acquire);
+        bool changed = false;
+
+        GameCommand command;
+        while (canAnswer() && m_commands.tryPop(command)) {
+            execute(command);
+            changed = true;
+        }
+        // one bot move per pass, and only once everything before it reached the UI
+        if (canAnswer() && playBots())
+            changed = true;
+
+        forwardEvents();
+        if (changed)
+            publishFrame();
+        else
+            m_wakeups.wait(seen, std::memory_order_acquire);
+    }
+}
+
+void GameWorker::execute(const GameCommand& command)
+{
+    if (m_aborted && command.type != GameCommandType::Start)
+        return;
+
+    switch (command.type) {
+    case GameCommandType::Start:
+        m_aborted = false;
+        m_game->startGame();
+        for (auto& bot : m_bots) {
+            if (!bot)
+                continue;
+            bot->placed = false;
+            bot->shooter->reset(m_gridSize);
+        }
+        break;
+    case GameCommandType::PlaceShip:
+        if (!m_game->placeShip(Position(command.x, command.y), Ship::PART_COUNT, command.orientation)) {
+            // forward what happened so far first, the rejection belongs after it
+            forwardEvents();
+            WorkerMessage message;
+            message.kind = WorkerMessage::Kind::PlacementRejected;
+            message.event.type = GameEventType::ShipPlaced;
+            message.event.player = m_game->getCurrentPlayer().lock() == m_game->getPlayer2() ? 1 : 0;
+            message.event.x = command.x;
+            message.event.y = command.y;
+            message.event.orientation = command.orientation;
+            message.event.state = m_game->getState();
+            // canAnswer() left room, and a refused placement publishes nothing
+            m_messages.tryPush(message);
+        }
+        break;
+    case GameCommandType::SwitchTurn:
+        m_game->switchTurn();
+        break;
+    case GameCommandType::Shoot:
+        m_game->shoot(Position(command.x, command.y));
+        break;
+    }
+}
+
+bool GameWorker::playBots()
+{
+    const int turn = m_game->getCurrentPlayer().lock() == m_game->getPlayer2() ? 1 : 0;
+    Bot* bot = m_bots[turn].get();
+    if (!bot || m_aborted)
+        return false;
+
+    const GameState state = m_game->getState();
+    if (state == GameState::PlacingShips) {
+        if (bot->placed)
+            return false;
+        bot->placed = true;
+        auto tryPlace = [this](const Ship& plane) {
+            return m_game->placeShip(plane.getHead(), Ship::PART_COUNT, plane.getOrientation());
+        };
+        if (!bot->placement->placeShips(m_gridSize, m_maxShips, tryPlace, bot->rng)) {
+            // the match cannot go on, as on the server; the planes it did place go out first
+            m_aborted = true;
+            m_held = WorkerMessage();
+            m_held.kind = WorkerMessage::Kind::MatchAborted;
+            m_held.event.type = GameEventType::ShipPlaced;
+            m_held.event.player = static_cast<std::uint8_t>(turn);
+            m_held.event.state = state;
+            m_holding = true;
+            forwardEvents();
+            return true;
+        }
+        m_game->switchTurn();
+        return true;
+    }
+
+    if (state == GameState::GameOver || m_game->isGameOver())
+        return false;
+
+    Position target = bot->shooter->nextShot(bot->rng);
+    if (target.m_x < 0)
+        return false;
+
+    auto opponent = turn == 0 ? m_game->getPlayer2() : m_game->getPlayer1();
+    m_game->shoot(target);
+    bot->shooter->onShotResult(opponent->getBoard()->getCellInfo(target));
+    return true;
+}
+
+void GameWorker::forwardEvents()
+{
+    EventBus& bus = m_game->getEventBus();
+    auto forward = [this](const GameEvent& event) {
+        WorkerMessage message;
+        message.event = event;
+        m_messages.tryPush(message);
+    };
+    // one at a time, so nothing leaves the bus unless the queue has room for it
+    while (!m_messages.full() && bus.drain(m_cursor, forward, 1) == 1) {
+    }
+    if (m_holding && bus.pending(m_cursor) == 0 && m_messages.tryPush(m_held))
+        m_holding = false;
+}
+
+bool GameWorker::canAnswer()
+{
+    forwardEvents();
+    return m_game->getEventBus().pending(m_cursor) == 0 && !m_holding && !m_messages.full();
+}
+
+void GameWorker::publishFrame()
+{
+    GameFrame& frame = m_frames.back();
+    frame.eventCount = m_game->getEventBus().getPublishedCount();
+    frame.state = m_game->getState();
+    frame.turn = m_game->getCurrentPlayer().lock() == m_game->getPlayer2() ? 1 : 0;
+
+    const std::shared_ptr<IPlayer> players[2] = { m_game->getPlayer1(), m_game->getPlayer2() };
+    for (int i = 0; i < 2; ++i) {
+        auto board = players[i] ? players[i]->getBoard() : nullptr;
+        if (board)
+            frame.boards[i].capture(board->getView(), board->getShipsCount());
+    }
+    m_frames.publish();
+}
+
+void GameWorker::wake()
+{
+    m_wakeups.fetch_add(1, std::memory_order_release);
+    m_wakeups.notify_one();
+}
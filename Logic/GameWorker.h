@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "IGame.h"
+#include "GameEvent.h"
+#include "GameFrame.h"
+#include "IPlacementStrategy.h"
+#include "IShootingStrategy.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+enum class GameCommandType : std::uint8_t {
+    Start,
+    PlaceShip,
+    SwitchTurn,
+    Shoot
+};
+
+struct GameCommand {
+    GameCommandType type{ GameCommandType::Start };
+    std::int16_t x{ 0 };
+    std::int16_t y{ 0 };
+    Orientation orientation{ Orientation::Up };
+};
+
+// What the logic thread tells the UI: a game event, a command the game turned down, or that a
+// bot could not place its planes and the match ended (event.player is the bot).
+struct WorkerMessage {
+    enum class Kind : std::uint8_t {
+        Event,
+        PlacementRejected,
+        MatchAborted
+    };
+
+    Kind kind{ Kind::Event };
+    GameEvent event;
+};
+
+// Owns a game and plays it on its own thread. The UI thread posts commands and drains messages
+// through SPSC queues and reads the boards from a triple-buffered GameFrame, so neither side
+// ever blocks on the other. Bots (setBot) move on the logic thread when it is their turn, one
+// move per pass so their events reach the UI and commands keep being answered in between.
+class GameWorker {
+public:
+    static constexpr std::size_t COMMAND_CAPACITY = 256;
+    static constexpr std::size_t MESSAGE_CAPACITY = 1024;
+
+    explicit GameWorker(std::unique_ptr<IGame> game);
+    ~GameWorker();
+
+    GameWorker(const GameWorker&) = delete;
+    GameWorker& operator=(const GameWorker&) = delete;
+
+    // Before start(): let a strategy play for player (0 or 1).
+    void setBot(int player, std::unique_ptr<IPlacementStrategy> placement,
+        std::unique_ptr<IShootingStrategy> shooter, std::uint64_t seed);
+
+    void start();
+    void stop();
+
+    // UI thread. Returns false when the command queue is full.
+    bool post(const GameCommand& command);
+
+    template <typename Fn>
+    std::size_t drainMessages(Fn&& fn, std::size_t maxMessages = MESSAGE_CAPACITY)
+    {
+        std::size_t count = m_messages.drain(fn, maxMessages);
+        if (count)
+            wake();     // the logic thread may be holding events back for lack of room
+        return count;
+    }
+
+    // UI thread: picks up the newest frame, true when it changed.
+    bool updateFrame();
+    const GameFrame& getFrame() const;
+
+    int getGridSize() const;
+    int getMaxShips() const;
+
+private:
+    struct Bot {
+        std::unique_ptr<IPlacementStrategy> placement;
+        std::unique_ptr<IShootingStrategy> shooter;
+        SplitMix64 rng;
+        bool placed{ false };
+    };
+
+    void run();
+    void execute(const GameCommand& command);
+    bool playBots();
+    void forwardEvents();
+    // Forwards what it can; true when nothing is held back and a message still fits, so the
+    // next command can be answered in order. Commands wait in their queue until then.
+    bool canAnswer();
+    void publishFrame();
+    void wake();
+
+    std::unique_ptr<IGame> m_game;
+    int m_gridSize;
+    int m_maxShips;
+    std::unique_ptr<Bot> m_bots[2];
+
+    SpscQueue<GameCommand, COMMAND_CAPACITY> m_commands;
+    SpscQueue<WorkerMessage, MESSAGE_CAPACITY> m_messages;
+    TripleBuffer<GameFrame> m_frames;
+    EventCursor m_cursor;
+    bool m_aborted{ false };    // only a Start command is served until the next match
+    bool m_holding{ false };    // m_held goes out once the events before it did
+    WorkerMessage m_held;
+
+    std::atomic<std::uint32_t> m_wakeups{ 0 };
+    std::atomic<bool> m_running{ false };
+    std::thread m_thread;
+};
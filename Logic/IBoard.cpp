@@ -0,0 +1,37 @@
+#include "IBoard.h"
+#include <iostream>
+
+void IBoard::print() const
+{
+    const BoardView view = getView();
+
+    std::cout << "\n   ";
+    for (int x = 0; x < view.size; ++x)
+        std::cout << x % 10 << " ";
+    std::cout << "\n";
+
+    for (int y = 0; y < view.size; ++y)
+    {
+        std::cout << (y < 10 ? " " : "") << y << " ";
+        for (int x = 0; x < view.size; ++x)
+        {
+            char cell;
+            switch (view.stateAt(x, y))
+            {
+            case CellState::Empty: cell = '.'; break;
+            case CellState::Ship:  cell = 'S'; break;
+            case CellState::Hit:   cell = 'X'; break;
+            case CellState::Miss:  cell = 'o'; break;
+            default: cell = '?'; break;
+            }
+            std::cout << cell << ' ';
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "\nLegenda: "
+        << "'.' = gol, "
+        << "'S' = nava, "
+        << "'X' = lovit, "
+        << "'o' = ratat\n";
+}
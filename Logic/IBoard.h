@@ -1,9 +1,14 @@
 #pragma once
+#include <span>
 #include <vector>
 #include "Position.h"
 #include "CellState.h"
 #include "Ship.h"
 #include "Cell.h"
+#include "Orientation.h"
+#include "ShotBatchResult.h"
+#include "BoardView.h"
+#include "GameSnapshot.h"
 
 class IBoard {
 public:
@@ -12,17 +17,25 @@ public:
     virtual bool placeShip(const Ship& ship) = 0;
 
     virtual bool receiveShot(const Position& p) = 0;
+    virtual ShotBatchResult receiveShots(std::span<const Position> positions) = 0;
     virtual void resetBoard() = 0;
     virtual CellState getCellState(const Position& p) const = 0;
     virtual int getShipsCount() const = 0;
     virtual int getSize() const = 0;
     virtual const std::vector<Ship>& getShips() const = 0;
 
-    virtual void print() const = 0;
+    // Writes the board to stdout, one character per cell, from getView().
+    virtual void print() const;
 
     virtual bool allShipsSunk() const = 0;
 
     virtual Cell getCellInfo(const Position& p) const = 0;
+    virtual BoardView getView() const = 0;
+
+    // Boards whose state does not fit a BoardSnapshot return false and are left unchanged.
+    virtual bool saveSnapshot(BoardSnapshot& snapshot) const = 0;
+    virtual bool loadSnapshot(const BoardSnapshot& snapshot) = 0;
 
     virtual bool canPlaceShip(const Ship& ship) const = 0;
+    virtual bool canPlaceShipAt(const Position& head, Orientation orientation) const = 0;
 };
@@ -0,0 +1,11 @@
+#pragma once
+#include <coroutine>
+
+// Runs suspended coroutines. post() may be called from any thread; the handle is resumed
+// once, on whichever thread the executor uses.
+class IExecutor {
+public:
+    virtual ~IExecutor() = default;
+
+    virtual void post(std::coroutine_handle<> handle) = 0;
+};
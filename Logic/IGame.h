@@ -4,6 +4,8 @@
 #include "Position.h"
 #include "Orientation.h"
 #include "IPlayer.h"
+#include "EventBus.h"
+#include "GameSnapshot.h"
 #include <string>
 #include <memory>
 
@@ -16,6 +18,8 @@ public:
     virtual void notifyShipPlaced(const Ship& ship) = 0;
     virtual void notifyShotFired(const Cell& cell) = 0;
     virtual void notifyGameStateChanged(GameState newState) = 0;
+    // Every notification is also published here, for subscribers that drain in batches.
+    virtual EventBus& getEventBus() = 0;
 
     virtual void startGame() = 0;
     virtual bool placeShip(const Position& start, int length = 1, Orientation orientation = Orientation::Up) = 0;
@@ -29,4 +33,9 @@ public:
     virtual std::shared_ptr<IPlayer> getPlayer2() const = 0;
     virtual std::weak_ptr<IPlayer> getCurrentPlayer() const = 0;
     virtual int getGridSize() const = 0;
+
+    // Whole game state as a trivially copyable value. Loading does not notify listeners;
+    // both return false for boards without a snapshot form (larger than 10x10).
+    virtual bool saveSnapshot(GameSnapshot& snapshot) const = 0;
+    virtual bool loadSnapshot(const GameSnapshot& snapshot) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include "Cell.h"
+#include "Orientation.h"
+
+class MatchDriver;
+
+struct Move {
+    enum class Kind : std::uint8_t {
+        PlaceShip,
+        Shoot,
+        Resign
+    };
+
+    Kind kind{ Kind::Resign };
+    std::int16_t x{ 0 };                // plane head or target cell
+    std::int16_t y{ 0 };
+    Orientation orientation{ Orientation::Up };   // PlaceShip
+};
+
+struct MoveRequest {
+    enum class Kind : std::uint8_t {
+        Placement,
+        Shot
+    };
+
+    Kind kind{ Kind::Shot };
+    int player{ 0 };
+    int placed{ 0 };                    // Placement: planes already on the board
+};
+
+// One-shot reply channel to a MatchDriver waiting for a move.
+class MoveSlot {
+public:
+    MoveSlot() = default;
+    explicit MoveSlot(MatchDriver* driver) : m_driver(driver) {}
+
+    // Any thread. Hands the move over and schedules the match; false when nobody is waiting.
+    bool deliver(const Move& move) const;
+
+    explicit operator bool() const { return m_driver != nullptr; }
+
+private:
+    MatchDriver* m_driver{ nullptr };
+};
+
+// Where one side's moves come from: a bot, UI clicks or a network connection. The driver calls
+// request() when it needs a move and suspends the match; the source answers through the slot,
+// right away or later from any thread, and no thread waits in between.
+class IMoveSource {
+public:
+    virtual ~IMoveSource() = default;
+
+    virtual void onMatchStart(int player, int boardSize, int maxShips) = 0;
+    virtual void request(const MoveRequest& request, MoveSlot slot) = 0;
+    // What the opponent board shows at the cell after this side's shot.
+    virtual void onShotResult(const Cell& cell) { (void)cell; }
+    // The move broke the rules; the same request follows.
+    virtual void onMoveRejected(const Move& move) { (void)move; }
+    // The match is going away: drop the slot of a pending request without answering it.
+    virtual void cancel() {}
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include <functional>
+#include "Ship.h"
+#include "SplitMix64.h"
+
+class IPlacementStrategy {
+public:
+    virtual ~IPlacementStrategy() = default;
+
+    // Offers planes to tryPlace until maxShips of them were accepted on a boardSize x boardSize board.
+    // Returns false when the planes could not all be placed.
+    virtual bool placeShips(int boardSize, int maxShips,
+        const std::function<bool(const Ship&)>& tryPlace, SplitMix64& rng) = 0;
+};
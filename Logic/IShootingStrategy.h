@@ -0,0 +1,15 @@
+#pragma once
+#include "Position.h"
+#include "Cell.h"
+#include "SplitMix64.h"
+
+class IShootingStrategy {
+public:
+    virtual ~IShootingStrategy() = default;
+
+    // Called at the start of every game.
+    virtual void reset(int boardSize) = 0;
+    virtual Position nextShot(SplitMix64& rng) = 0;
+    // What the opponent board shows at the cell after the shot.
+    virtual void onShotResult(const Cell& cell) = 0;
+};
@@ -0,0 +1,326 @@
+#include "LayoutDatabase.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include "Symmetry.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr char MAGIC[4] = { 'A', 'V', 'L', 'D' };
+    constexpr std::size_t ALIGNMENT = 64;
+    // layouts tested per pass of the branch free loop
+    constexpr std::size_t BLOCK = 1024;
+
+    static_assert(std::endian::native == std::endian::little, "the layout file is read in place");
+
+    std::size_t alignUp(std::size_t offset)
+    {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    struct Offsets {
+        std::size_t words[4]{};     // occupied low, occupied high, heads low, heads high
+        std::size_t images{ 0 };
+        std::size_t placements{ 0 };
+        std::size_t end{ 0 };
+    };
+
+    Offsets offsetsFor(std::uint64_t stored, int planeCount)
+    {
+        Offsets offsets;
+        std::size_t next = LayoutDatabase::HEADER_SIZE;
+        for (auto& offset : offsets.words) {
+            offset = next;
+            next = alignUp(next + stored * sizeof(std::uint64_t));
+        }
+        offsets.images = next;
+        offsets.placements = alignUp(next + stored);
+        offsets.end = offsets.placements + stored * static_cast<std::size_t>(planeCount);
+        return offsets;
+    }
+}
+
+LayoutDatabase::~LayoutDatabase()
+{
+    close();
+}
+
+bool LayoutDatabase::write(const std::string& path, int planeCount)
+{
+    if (planeCount <= 0 || planeCount > LayoutEnumerator::MAX_PLANES)
+        return false;
+
+    std::vector<std::uint64_t> words[4];
+    std::vector<std::uint8_t> images;
+    std::vector<std::uint8_t> placements;
+    std::uint64_t count = 0;
+    LayoutEnumerator enumerator(planeCount);
+    const std::uint64_t stored = enumerator.forEachCanonicalLayout(
+        [&](const std::uint16_t* ids, int planes, std::uint8_t distinct) {
+            BitMask128 occupied;
+            BitMask128 heads;
+            std::uint8_t sorted[LayoutEnumerator::MAX_PLANES];
+            for (int i = 0; i < planes; ++i) {
+                const auto& placement = PlacementTable::PLACEMENTS[ids[i]];
+                occupied |= placement.mask;
+                heads.set(placement.head);
+                sorted[i] = static_cast<std::uint8_t>(ids[i]);
+            }
+            std::sort(sorted, sorted + planes);
+            words[0].push_back(occupied.words[0]);
+            words[1].push_back(occupied.words[1]);
+            words[2].push_back(heads.words[0]);
+            words[3].push_back(heads.words[1]);
+            images.push_back(distinct);
+            count += static_cast<std::uint64_t>(BitOps::popcount(distinct));
+            placements.insert(placements.end(), sorted, sorted + planes);
+        });
+
+    const Offsets offsets = offsetsFor(stored, planeCount);
+    std::vector<std::uint8_t> bytes(offsets.end, 0);
+    std::memcpy(bytes.data(), MAGIC, sizeof(MAGIC));
+    bytes[4] = VERSION;
+    bytes[5] = static_cast<std::uint8_t>(PlacementTable::BOARD_SIZE);
+    bytes[6] = static_cast<std::uint8_t>(planeCount);
+    std::memcpy(bytes.data() + 8, &count, sizeof(count));
+    std::memcpy(bytes.data() + 16, &stored, sizeof(stored));
+    for (int w = 0; w < 4; ++w) {
+        if (stored)
+            std::memcpy(bytes.data() + offsets.words[w], words[w].data(), stored * sizeof(std::uint64_t));
+    }
+    if (stored)
+        std::memcpy(bytes.data() + offsets.images, images.data(), images.size());
+    if (!placements.empty())
+        std::memcpy(bytes.data() + offsets.placements, placements.data(), placements.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+bool LayoutDatabase::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0
+        ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat info {};
+    void* view = ::fstat(fd, &info) == 0 && info.st_size > 0
+        ? ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return false;
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    std::uint64_t count = 0;
+    std::uint64_t stored = 0;
+    const int planeCount = m_size >= HEADER_SIZE ? m_data[6] : 0;
+    if (m_size >= HEADER_SIZE) {
+        std::memcpy(&count, m_data + 8, sizeof(count));
+        std::memcpy(&stored, m_data + 16, sizeof(stored));
+    }
+    // stored * 8 + symmetry has to fit the u32 matches
+    if (m_size < HEADER_SIZE || std::memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0 || m_data[4] != VERSION
+        || m_data[5] != PlacementTable::BOARD_SIZE || planeCount <= 0 || planeCount > LayoutEnumerator::MAX_PLANES
+        || stored > std::uint64_t{ 0xFFFFFFFF } / Symmetry::COUNT) {
+        close();
+        return false;
+    }
+
+    const Offsets offsets = offsetsFor(stored, planeCount);
+    if (offsets.end != m_size) {
+        close();
+        return false;
+    }
+
+    // every stored layout stands for itself (bit 0) and the images add up to the layout count
+    const std::uint8_t* images = m_data + offsets.images;
+    const std::uint8_t* placements = m_data + offsets.placements;
+    std::uint64_t represented = 0;
+    bool listed = true;
+    for (std::uint64_t i = 0; i < stored; ++i) {
+        listed = listed && (images[i] & 1u);
+        represented += static_cast<std::uint64_t>(BitOps::popcount(images[i]));
+    }
+    if (!listed || represented != count
+        || std::any_of(placements, placements + stored * planeCount, [](std::uint8_t id) { return id >= PlacementTable::COUNT; })) {
+        close();
+        return false;
+    }
+
+    m_planeCount = planeCount;
+    m_count = count;
+    m_stored = stored;
+    m_occupied[0] = reinterpret_cast<const std::uint64_t*>(m_data + offsets.words[0]);
+    m_occupied[1] = reinterpret_cast<const std::uint64_t*>(m_data + offsets.words[1]);
+    m_heads[0] = reinterpret_cast<const std::uint64_t*>(m_data + offsets.words[2]);
+    m_heads[1] = reinterpret_cast<const std::uint64_t*>(m_data + offsets.words[3]);
+    m_images = images;
+    m_placements = placements;
+    return true;
+}
+
+void LayoutDatabase::close()
+{
+    if (m_data) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+        m_file = nullptr;
+        m_mapping = nullptr;
+#else
+        ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_planeCount = 0;
+    m_count = 0;
+    m_stored = 0;
+    m_occupied[0] = m_occupied[1] = nullptr;
+    m_heads[0] = m_heads[1] = nullptr;
+    m_images = nullptr;
+    m_placements = nullptr;
+}
+
+bool LayoutDatabase::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+int LayoutDatabase::getPlaneCount() const
+{
+    return m_planeCount;
+}
+
+std::uint64_t LayoutDatabase::getLayoutCount() const
+{
+    return m_count;
+}
+
+std::uint64_t LayoutDatabase::getStoredCount() const
+{
+    return m_stored;
+}
+
+void LayoutDatabase::getLayout(std::uint32_t match, std::uint8_t* ids) const
+{
+    const std::uint8_t* stored = m_placements + static_cast<std::uint64_t>(match / Symmetry::COUNT) * m_planeCount;
+    const auto& map = Symmetry::PLACEMENTS[match % Symmetry::COUNT];
+    for (int i = 0; i < m_planeCount; ++i)
+        ids[i] = map[stored[i]];
+}
+
+template <typename Fn>
+void LayoutDatabase::forEachMatch(const LayoutObservation& observation, Fn&& fn) const
+{
+    const std::uint64_t* occupied0 = m_occupied[0];
+    const std::uint64_t* occupied1 = m_occupied[1];
+    const std::uint64_t* heads0 = m_heads[0];
+    const std::uint64_t* heads1 = m_heads[1];
+    const std::uint8_t* images = m_images;
+
+    // The image of a stored layout under s fits the observation exactly when the stored layout
+    // fits the observation mirrored back, so each symmetry is one pass over the stored masks.
+    for (int s = 0; s < Symmetry::COUNT; ++s) {
+        const LayoutObservation mirrored = Symmetry::apply(observation, Symmetry::INVERSE[s]);
+        const std::uint64_t miss0 = mirrored.misses.words[0], miss1 = mirrored.misses.words[1];
+        const std::uint64_t hit0 = mirrored.hits.words[0], hit1 = mirrored.hits.words[1];
+        const std::uint64_t head0 = mirrored.heads.words[0], head1 = mirrored.heads.words[1];
+
+        // A layout fits when it has no part on a miss, a part on every hit, and its heads on the
+        // hit cells are exactly the heads seen; images that repeat a lower symmetry's are skipped.
+        // The first loop has no branches so it vectorizes; the second only visits the survivors.
+        std::uint64_t conflicts[BLOCK];
+        for (std::size_t base = 0; base < m_stored; base += BLOCK) {
+            const std::size_t length = std::min<std::size_t>(BLOCK, m_stored - base);
+            for (std::size_t i = 0; i < length; ++i) {
+                const std::uint64_t o0 = occupied0[base + i], o1 = occupied1[base + i];
+                conflicts[i] = (o0 & miss0) | (o1 & miss1) | ((o0 & hit0) ^ hit0) | ((o1 & hit1) ^ hit1)
+                    | ((heads0[base + i] & hit0) ^ head0) | ((heads1[base + i] & hit1) ^ head1)
+                    | (((images[base + i] >> s) & 1u) ^ 1u);
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                if (!conflicts[i])
+                    fn(static_cast<std::uint32_t>(base + i), s);
+            }
+        }
+    }
+}
+
+std::size_t LayoutDatabase::filter(const LayoutObservation& observation, std::vector<std::uint32_t>& matches) const
+{
+    const std::size_t before = matches.size();
+    forEachMatch(observation, [&matches](std::uint32_t layout, int symmetry) {
+        matches.push_back(layout * Symmetry::COUNT + static_cast<std::uint32_t>(symmetry));
+    });
+    return matches.size() - before;
+}
+
+std::uint64_t LayoutDatabase::countDensity(const LayoutObservation& observation, LayoutDensity& density) const
+{
+    // tallied per symmetry under the stored ids, then moved to their images once
+    std::uint64_t layouts = 0;
+    std::uint64_t stored[Symmetry::COUNT][PlacementTable::COUNT]{};
+    forEachMatch(observation, [&](std::uint32_t layout, int symmetry) {
+        const std::uint8_t* ids = m_placements + static_cast<std::uint64_t>(layout) * m_planeCount;
+        for (int i = 0; i < m_planeCount; ++i)
+            ++stored[symmetry][ids[i]];
+        ++layouts;
+    });
+
+    std::uint64_t weights[PlacementTable::COUNT]{};
+    for (int s = 0; s < Symmetry::COUNT; ++s) {
+        for (int id = 0; id < PlacementTable::COUNT; ++id)
+            weights[Symmetry::PLACEMENTS[s][id]] += stored[s][id];
+    }
+
+    density = LayoutDensity();
+    density.layouts = layouts;
+    for (int id = 0; id < PlacementTable::COUNT; ++id) {
+        if (!weights[id])
+            continue;
+        const auto& placement = PlacementTable::PLACEMENTS[id];
+        density.heads[placement.head] += weights[id];
+        if (observation.heads.test(placement.head))
+            continue;
+        for (int cell : placement.cells)
+            density.occupied[cell] += weights[id];
+    }
+    return layouts;
+}
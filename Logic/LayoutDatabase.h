@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "LayoutEnumerator.h"
+
+// Read-only file of every layout of N planes on the classic board, written once at build time
+// (the layoutdb tool) and memory-mapped by every process that filters layouts, so they all
+// share one copy in the page cache. Only one layout per symmetry class is stored (see
+// Symmetry::layoutImages); the others are matched by filtering against the mirrored
+// observations, so the file is close to 8x smaller and its masks stay in cache.
+//
+// File layout, little endian:
+//   [0..3]    magic "AVLD"
+//   [4]       format version
+//   [5]       board size (10)
+//   [6]       planes per layout
+//   [7]       reserved, zero
+//   [8..15]   layout count N, symmetric images included
+//   [16..23]  stored layout count S
+//   [24..63]  reserved, zero
+// then, each starting on a 64 byte boundary, one array per field (structure of arrays):
+//   occupied low / high words   S x u64   every plane part, bit y * 10 + x
+//   head low / high words       S x u64   the plane heads
+//   images                      S x u8    bit s: symmetry s gives a layout not listed before
+//   placements                  S x planes x u8, PlacementTable ids
+class LayoutDatabase {
+public:
+    static constexpr std::uint8_t VERSION = 2;
+    static constexpr std::size_t HEADER_SIZE = 64;
+
+    LayoutDatabase() = default;
+    ~LayoutDatabase();
+
+    LayoutDatabase(const LayoutDatabase&) = delete;
+    LayoutDatabase& operator=(const LayoutDatabase&) = delete;
+
+    // Enumerates the canonical layouts of planeCount planes and writes the file; false on I/O errors.
+    static bool write(const std::string& path, int planeCount);
+
+    // Maps the file; false, leaving the database closed, if it is missing or does not validate.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    int getPlaneCount() const;
+    std::uint64_t getLayoutCount() const;
+    std::uint64_t getStoredCount() const;
+    // Writes the planeCount PlacementTable ids of a layout returned by filter().
+    void getLayout(std::uint32_t match, std::uint8_t* ids) const;
+
+    // Appends every layout consistent with the observation, as stored index * 8 + symmetry;
+    // returns how many.
+    std::size_t filter(const LayoutObservation& observation, std::vector<std::uint32_t>& matches) const;
+    // Same tallies as LayoutEnumerator::countDensity.
+    std::uint64_t countDensity(const LayoutObservation& observation, LayoutDensity& density) const;
+
+private:
+    // Calls fn(stored index, symmetry) for every match.
+    template <typename Fn>
+    void forEachMatch(const LayoutObservation& observation, Fn&& fn) const;
+
+    const std::uint8_t* m_data{ nullptr };
+    std::size_t m_size{ 0 };
+    int m_planeCount{ 0 };
+    std::uint64_t m_count{ 0 };
+    std::uint64_t m_stored{ 0 };
+    const std::uint64_t* m_occupied[2]{};
+    const std::uint64_t* m_heads[2]{};
+    const std::uint8_t* m_images{ nullptr };
+    const std::uint8_t* m_placements{ nullptr };
+#ifdef _WIN32
+    void* m_file{ nullptr };
+    void* m_mapping{ nullptr };
+#endif
+};
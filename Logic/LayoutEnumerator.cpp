@@ -0,0 +1,253 @@
+#include "LayoutEnumerator.h"
+#include <algorithm>
+#include "Symmetry.h"
+
+using PlacementSet = LayoutEnumerator::PlacementSet;
+
+namespace
+{
+    constexpr int COUNT = PlacementTable::COUNT;
+
+    struct Tables {
+        PlacementSet compatible[COUNT];
+        // compatible placements with a higher id, so subsets are counted once
+        PlacementSet compatibleAbove[COUNT];
+        PlacementSet covering[PlacementTable::CELL_COUNT];
+
+        Tables()
+        {
+            for (int a = 0; a < COUNT; ++a) {
+                const auto& placement = PlacementTable::PLACEMENTS[a];
+                for (int cell : placement.cells)
+                    covering[cell].set(a);
+                for (int b = 0; b < COUNT; ++b) {
+                    if ((placement.mask & PlacementTable::PLACEMENTS[b].mask).any())
+                        continue;
+                    compatible[a].set(b);
+                    if (b > a)
+                        compatibleAbove[a].set(b);
+                }
+            }
+        }
+    };
+
+    const Tables& tables()
+    {
+        static const Tables instance;
+        return instance;
+    }
+
+    // Sets of k pairwise compatible placements out of available.
+    std::uint64_t countSubsets(const PlacementSet& available, int k)
+    {
+        if (k == 0)
+            return 1;
+        if (k == 1)
+            return static_cast<std::uint64_t>(available.count());
+
+        const Tables& t = tables();
+        std::uint64_t count = 0;
+        available.forEach([&](int id) {
+            count += countSubsets(available & t.compatibleAbove[id], k - 1);
+        });
+        return count;
+    }
+
+    struct CountSearch {
+        std::uint64_t weights[COUNT]{};
+        std::uint64_t total{ 0 };
+        std::uint16_t chosen[LayoutEnumerator::MAX_PLANES]{};
+    };
+
+    // The hit cells are all covered by the chosen planes; the remaining ones can be any
+    // compatible set out of available. Every placement is credited with the layouts it is in.
+    void countFree(const PlacementSet& available, int remaining, int depth, CountSearch& search)
+    {
+        const Tables& t = tables();
+        std::uint64_t layouts = 1;
+        if (remaining > 0) {
+            std::uint64_t memberships = 0;
+            available.forEach([&](int id) {
+                std::uint64_t with = countSubsets(available & t.compatible[id], remaining - 1);
+                search.weights[id] += with;
+                memberships += with;
+            });
+            layouts = memberships / static_cast<std::uint64_t>(remaining);
+        }
+
+        for (int i = 0; i < depth; ++i)
+            search.weights[search.chosen[i]] += layouts;
+        search.total += layouts;
+    }
+
+    template <typename OnCovered>
+    void coverHits(const PlacementSet& available, BitMask128 uncovered, int remaining, int depth,
+        std::uint16_t* chosen, OnCovered&& onCovered)
+    {
+        if (uncovered.none()) {
+            onCovered(available, remaining, depth);
+            return;
+        }
+        if (remaining == 0 || uncovered.count() > remaining * PlacementTable::PART_COUNT)
+            return;
+
+        int lowest = uncovered.words[0] ? BitOps::lowestBit(uncovered.words[0]) : 64 + BitOps::lowestBit(uncovered.words[1]);
+        const Tables& t = tables();
+        (available & t.covering[lowest]).forEach([&](int id) {
+            chosen[depth] = static_cast<std::uint16_t>(id);
+            coverHits(available & t.compatible[id], uncovered & ~PlacementTable::PLACEMENTS[id].mask,
+                remaining - 1, depth + 1, chosen, onCovered);
+        });
+    }
+
+    void listFree(const PlacementSet& available, int remaining, std::uint16_t* chosen, int depth,
+        const std::function<void(const std::uint16_t*, int)>& fn, std::uint64_t& total)
+    {
+        if (remaining == 0) {
+            fn(chosen, depth);
+            ++total;
+            return;
+        }
+        const Tables& t = tables();
+        available.forEach([&](int id) {
+            chosen[depth] = static_cast<std::uint16_t>(id);
+            listFree(available & t.compatibleAbove[id], remaining - 1, chosen, depth + 1, fn, total);
+        });
+    }
+}
+
+int PlacementSet::count() const
+{
+    int count = 0;
+    for (auto word : words)
+        count += BitOps::popcount(word);
+    return count;
+}
+
+bool PlacementSet::none() const
+{
+    for (auto word : words)
+        if (word)
+            return false;
+    return true;
+}
+
+PlacementSet PlacementSet::operator&(const PlacementSet& other) const
+{
+    PlacementSet result;
+    for (int w = 0; w < SET_WORDS; ++w)
+        result.words[w] = words[w] & other.words[w];
+    return result;
+}
+
+LayoutEnumerator::LayoutEnumerator(int planeCount)
+    : m_planeCount(std::clamp(planeCount, 0, MAX_PLANES))
+{
+}
+
+int LayoutEnumerator::getPlaneCount() const
+{
+    return m_planeCount;
+}
+
+PlacementSet LayoutEnumerator::allowedPlacements(const LayoutObservation& observation) const
+{
+    const BitMask128 plainHits = observation.hits & ~observation.heads;
+    PlacementSet allowed;
+    for (int id = 0; id < COUNT; ++id) {
+        const auto& placement = PlacementTable::PLACEMENTS[id];
+        const BitMask128 head = BitMask128::fromBit(placement.head);
+        // a plane may not touch a miss, put its head on a plain hit, or a body part on a head
+        if ((placement.mask & observation.misses).any() || (head & plainHits).any()
+            || (placement.mask & observation.heads & ~head).any())
+            continue;
+        allowed.set(id);
+    }
+    return allowed;
+}
+
+std::uint64_t LayoutEnumerator::countDensity(const LayoutObservation& observation, LayoutDensity& density) const
+{
+    return countDensity(observation, allowedPlacements(observation), density);
+}
+
+std::uint64_t LayoutEnumerator::countDensity(const LayoutObservation& observation, const PlacementSet& allowed, LayoutDensity& density) const
+{
+    CountSearch search;
+    coverHits(allowed, observation.hits, m_planeCount, 0, search.chosen,
+        [&search](const PlacementSet& available, int remaining, int depth) {
+            countFree(available, remaining, depth, search);
+        });
+
+    density = LayoutDensity();
+    density.layouts = search.total;
+    for (int id = 0; id < COUNT; ++id) {
+        const std::uint64_t weight = search.weights[id];
+        if (!weight)
+            continue;
+        const auto& placement = PlacementTable::PLACEMENTS[id];
+        density.heads[placement.head] += weight;
+        if (observation.heads.test(placement.head))
+            continue;
+        for (int cell : placement.cells)
+            density.occupied[cell] += weight;
+    }
+    return search.total;
+}
+
+std::uint64_t LayoutEnumerator::forEachLayout(const LayoutObservation& observation,
+    const std::function<void(const std::uint16_t* ids, int count)>& fn) const
+{
+    std::uint16_t chosen[MAX_PLANES]{};
+    std::uint64_t total = 0;
+    coverHits(allowedPlacements(observation), observation.hits, m_planeCount, 0, chosen,
+        [&](const PlacementSet& available, int remaining, int depth) {
+            listFree(available, remaining, chosen, depth, fn, total);
+        });
+    return total;
+}
+
+std::uint64_t LayoutEnumerator::forEachCanonicalLayout(
+    const std::function<void(const std::uint16_t* ids, int count, std::uint8_t images)>& fn) const
+{
+    std::uint16_t chosen[MAX_PLANES]{};
+    std::uint64_t total = 0;
+    if (m_planeCount == 0) {
+        fn(chosen, 0, 1);
+        return 1;
+    }
+
+    // ids come out in increasing order, so the first plane is the layout's lowest id
+    auto listCanonical = [&](const std::uint16_t* ids, int count) {
+        std::uint8_t narrow[MAX_PLANES];
+        for (int i = 0; i < count; ++i)
+            narrow[i] = static_cast<std::uint8_t>(ids[i]);
+        if (std::uint8_t images = Symmetry::layoutImages(narrow, count)) {
+            fn(ids, count, images);
+            ++total;
+        }
+    };
+
+    std::uint64_t listed = 0;
+    const Tables& t = tables();
+    for (int id = 0; id < COUNT; ++id) {
+        bool lowest = true;
+        for (int s = 1; s < Symmetry::COUNT && lowest; ++s)
+            lowest = Symmetry::PLACEMENTS[s][id] >= id;
+        if (!lowest)
+            continue;
+        chosen[0] = static_cast<std::uint16_t>(id);
+        listFree(t.compatibleAbove[id], m_planeCount - 1, chosen, 1, listCanonical, listed);
+    }
+    return total;
+}
+
+const PlacementSet& LayoutEnumerator::compatible(int id)
+{
+    return tables().compatible[id];
+}
+
+const PlacementSet& LayoutEnumerator::covering(int cell)
+{
+    return tables().covering[cell];
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include "BitMask.h"
+#include "PlacementTable.h"
+
+// What a shooter has seen of the classic 10x10 opponent board.
+struct LayoutObservation {
+    BitMask128 hits;
+    BitMask128 misses;
+    // hit cells that showed a plane head; a subset of hits
+    BitMask128 heads;
+
+    void record(int cell, bool hit, bool head)
+    {
+        if (!hit)
+            misses.set(cell);
+        else {
+            hits.set(cell);
+            if (head)
+                heads.set(cell);
+        }
+    }
+};
+
+// Per-cell tallies over every layout consistent with an observation.
+struct LayoutDensity {
+    std::uint64_t layouts{ 0 };
+    // layouts with a part of a live plane / a plane head on the cell; a plane whose head was
+    // hit is destroyed, so its parts no longer count as occupied
+    std::array<std::uint64_t, PlacementTable::CELL_COUNT> occupied{};
+    std::array<std::uint64_t, PlacementTable::CELL_COUNT> heads{};
+};
+
+// Works through every layout of planeCount non-overlapping planes on the classic board that
+// agrees with an observation: no part on a miss, every hit covered, and a head exactly on the
+// hit cells that showed one.
+//
+// A layout is built by taking, for the lowest hit cell not yet covered, each placement that
+// could cover it; once every hit is covered the remaining planes are free and are counted
+// with bit set intersections instead of being listed. Every layout comes up exactly once.
+class LayoutEnumerator {
+public:
+    static constexpr int SET_WORDS = (PlacementTable::COUNT + 63) / 64;
+    static constexpr int MAX_PLANES = 10;
+
+    // One bit per PlacementTable id.
+    struct PlacementSet {
+        std::uint64_t words[SET_WORDS]{};
+
+        bool test(int id) const { return (words[id >> 6] >> (id & 63)) & 1u; }
+        void set(int id) { words[id >> 6] |= std::uint64_t{ 1 } << (id & 63); }
+        int count() const;
+        bool none() const;
+        PlacementSet operator&(const PlacementSet& other) const;
+
+        template <typename Fn>
+        void forEach(Fn&& fn) const
+        {
+            for (int w = 0; w < SET_WORDS; ++w) {
+                std::uint64_t bits = words[w];
+                while (bits) {
+                    fn(w * 64 + BitOps::lowestBit(bits));
+                    bits &= bits - 1;
+                }
+            }
+        }
+    };
+
+    explicit LayoutEnumerator(int planeCount = 3);
+
+    int getPlaneCount() const;
+
+    // Placements that can be part of a consistent layout on their own.
+    PlacementSet allowedPlacements(const LayoutObservation& observation) const;
+
+    // Tallies every consistent layout; returns their number.
+    std::uint64_t countDensity(const LayoutObservation& observation, LayoutDensity& density) const;
+    // Same, with allowedPlacements(observation) already at hand (kept by a CandidateTracker).
+    std::uint64_t countDensity(const LayoutObservation& observation, const PlacementSet& allowed, LayoutDensity& density) const;
+
+    // Lists every consistent layout as planeCount placement ids, in no particular order.
+    // Meant for checks and offline tools: the opening position has hundreds of thousands.
+    std::uint64_t forEachLayout(const LayoutObservation& observation,
+        const std::function<void(const std::uint16_t* ids, int count)>& fn) const;
+
+    // Lists one layout of every symmetry class of the empty board (see Symmetry::layoutImages),
+    // with the bit set of its distinct images; returns how many were listed. The first plane only
+    // starts from placements that are the lowest id of their own images, which cuts the search
+    // about eightfold.
+    std::uint64_t forEachCanonicalLayout(
+        const std::function<void(const std::uint16_t* ids, int count, std::uint8_t images)>& fn) const;
+
+    // Placements that do not overlap the given one (never itself).
+    static const PlacementSet& compatible(int id);
+    // Placements with a part on the cell.
+    static const PlacementSet& covering(int cell);
+
+private:
+    int m_planeCount;
+};
@@ -0,0 +1,238 @@
+#include "LayoutSampler.h"
+#include <algorithm>
+#include <thread>
+#include "BitMask.h"
+#include "PlacementTable.h"
+
+namespace
+{
+    // random tries to fit each plane that does not have to cover a hit
+    constexpr int FREE_TRIES = 64;
+    // samples between two looks at the clock
+    constexpr int CLOCK_STRIDE = 16;
+    // at most 10 parts x 4 orientations cover a cell
+    constexpr int MAX_COVER = PlacementTable::PART_COUNT * PlacementTable::ORIENTATION_COUNT;
+
+    struct Attempt {
+        std::vector<std::uint8_t> occupied;
+        std::vector<int> chosen;
+        int uncovered{ 0 };
+        int steps{ 0 };
+    };
+}
+
+LayoutSampler::LayoutSampler(int boardSize, int planeCount)
+    : m_size(boardSize), m_planeCount(planeCount), m_tracker(boardSize), m_seen(static_cast<std::size_t>(boardSize) * boardSize, Seen::Unknown)
+{
+    updateCandidates();
+}
+
+void LayoutSampler::reset()
+{
+    std::fill(m_seen.begin(), m_seen.end(), Seen::Unknown);
+    m_hits.clear();
+    m_tracker.reset(m_size);
+    updateCandidates();
+}
+
+void LayoutSampler::record(int x, int y, bool hit, bool head)
+{
+    if (x < 0 || x >= m_size || y < 0 || y >= m_size)
+        return;
+    const int cell = y * m_size + x;
+    if (m_seen[cell] != Seen::Unknown)
+        return;
+    m_seen[cell] = !hit ? Seen::Miss : (head ? Seen::Head : Seen::Hit);
+    if (hit)
+        m_hits.push_back(cell);
+    m_tracker.record(x, y, hit, head);
+    updateCandidates();
+}
+
+int LayoutSampler::getBoardSize() const
+{
+    return m_size;
+}
+
+int LayoutSampler::getPlaneCount() const
+{
+    return m_planeCount;
+}
+
+void LayoutSampler::updateCandidates()
+{
+    Candidates& result = m_candidates;
+    result.allowed.clear();
+    const auto& live = m_tracker.getLive();
+    for (int w = 0; w < static_cast<int>(live.size()); ++w) {
+        for (std::uint64_t bits = live[w]; bits; bits &= bits - 1)
+            result.allowed.push_back(w * 64 + BitOps::lowestBit(bits));
+    }
+
+    // only hit cells need their covering placements
+    const int cellCount = m_size * m_size;
+    result.coverStart.assign(cellCount + 1, 0);
+    result.cover.clear();
+    for (int cell = 0; cell < cellCount; ++cell) {
+        if (m_seen[cell] == Seen::Hit || m_seen[cell] == Seen::Head) {
+            for (int id : m_tracker.getCovering(cell)) {
+                if (m_tracker.isCandidate(id))
+                    result.cover.push_back(id);
+            }
+        }
+        result.coverStart[cell + 1] = static_cast<int>(result.cover.size());
+    }
+}
+
+SampleHeatmap LayoutSampler::sample(const SamplerConfig& config) const
+{
+    const auto deadline = std::chrono::steady_clock::now() + config.budget;
+    const Candidates& shared = m_candidates;
+    const std::size_t cellCount = static_cast<std::size_t>(m_size) * m_size;
+
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(threads, 1);
+    // the sample cap is split between the threads
+    const std::uint64_t perThread = config.maxSamples ? (config.maxSamples + threads - 1) / threads : 0;
+
+    std::vector<SampleHeatmap> partial(threads);
+    for (auto& heatmap : partial) {
+        heatmap.occupied.assign(cellCount, 0);
+        heatmap.heads.assign(cellCount, 0);
+    }
+
+    if (threads == 1) {
+        sampleThread(shared, SplitMix64::forStream(config.seed, 0), deadline, perThread, partial[0]);
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] { sampleThread(shared, SplitMix64::forStream(config.seed, t), deadline, perThread, partial[t]); });
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    SampleHeatmap result = std::move(partial[0]);
+    for (int t = 1; t < threads; ++t) {
+        result.samples += partial[t].samples;
+        result.rejected += partial[t].rejected;
+        for (std::size_t cell = 0; cell < cellCount; ++cell) {
+            result.occupied[cell] += partial[t].occupied[cell];
+            result.heads[cell] += partial[t].heads[cell];
+        }
+    }
+    return result;
+}
+
+void LayoutSampler::sampleThread(const Candidates& candidates, SplitMix64 rng,
+    std::chrono::steady_clock::time_point deadline, std::uint64_t maxSamples, SampleHeatmap& heatmap) const
+{
+    if (candidates.allowed.empty() || m_planeCount <= 0)
+        return;
+
+    Attempt attempt;
+    attempt.occupied.assign(m_seen.size(), 0);
+    attempt.chosen.reserve(m_planeCount);
+
+    auto fits = [&](int id) {
+        for (int cell : m_tracker.getCells(id))
+            if (attempt.occupied[cell])
+                return false;
+        return true;
+    };
+    auto put = [&](int id, int mark) {
+        for (int cell : m_tracker.getCells(id)) {
+            attempt.occupied[cell] = static_cast<std::uint8_t>(mark);
+            if (m_seen[cell] == Seen::Hit || m_seen[cell] == Seen::Head)
+                attempt.uncovered -= mark ? 1 : -1;
+        }
+        if (mark)
+            attempt.chosen.push_back(id);
+        else
+            attempt.chosen.pop_back();
+    };
+
+    // planes that do not have to cover anything: random fits, no backtracking
+    auto placeFree = [&]() {
+        const int placedBefore = static_cast<int>(attempt.chosen.size());
+        while (static_cast<int>(attempt.chosen.size()) < m_planeCount) {
+            bool placed = false;
+            for (int tries = 0; tries < FREE_TRIES && !placed; ++tries) {
+                int id = candidates.allowed[rng.nextInt(static_cast<int>(candidates.allowed.size()))];
+                if (fits(id)) {
+                    put(id, 1);
+                    placed = true;
+                }
+            }
+            if (!placed) {
+                while (static_cast<int>(attempt.chosen.size()) > placedBefore)
+                    put(attempt.chosen.back(), 0);
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // covers the lowest uncovered hit with each fitting placement in random order
+    auto coverHits = [&](auto& self) -> bool {
+        if (++attempt.steps > MAX_STEPS)
+            return false;
+        if (attempt.uncovered == 0)
+            return placeFree();
+        const int remaining = m_planeCount - static_cast<int>(attempt.chosen.size());
+        if (remaining == 0 || attempt.uncovered > remaining * PlacementTable::PART_COUNT)
+            return false;
+
+        int hit = -1;
+        for (int cell : m_hits) {
+            if (!attempt.occupied[cell]) {
+                hit = cell;
+                break;
+            }
+        }
+
+        int order[MAX_COVER];
+        int count = 0;
+        for (int i = candidates.coverStart[hit]; i < candidates.coverStart[hit + 1] && count < MAX_COVER; ++i)
+            order[count++] = candidates.cover[i];
+        for (int i = count - 1; i > 0; --i)
+            std::swap(order[i], order[rng.nextInt(i + 1)]);
+
+        for (int i = 0; i < count; ++i) {
+            if (!fits(order[i]))
+                continue;
+            put(order[i], 1);
+            if (self(self))
+                return true;
+            put(order[i], 0);
+            if (attempt.steps > MAX_STEPS)
+                return false;
+        }
+        return false;
+    };
+
+    for (std::uint64_t attempts = 0; !maxSamples || heatmap.samples < maxSamples; ++attempts) {
+        if (attempts % CLOCK_STRIDE == 0 && std::chrono::steady_clock::now() >= deadline)
+            break;
+
+        attempt.uncovered = static_cast<int>(m_hits.size());
+        attempt.steps = 0;
+        if (!coverHits(coverHits)) {
+            ++heatmap.rejected;
+            continue;
+        }
+
+        ++heatmap.samples;
+        while (!attempt.chosen.empty()) {
+            const std::span<const int> cells = m_tracker.getCells(attempt.chosen.back());
+            // a plane with its head hit is destroyed, nothing left to shoot at
+            if (m_seen[cells[0]] != Seen::Head) {
+                for (int cell : cells)
+                    ++heatmap.occupied[cell];
+            }
+            ++heatmap.heads[cells[0]];
+            put(attempt.chosen.back(), 0);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "CandidateTracker.h"
+#include "SplitMix64.h"
+
+struct SamplerConfig {
+    int threads{ 1 };                  // 0 = one per hardware thread
+    std::uint64_t seed{ 1 };
+    // wall clock allowed for one call to sample()
+    std::chrono::microseconds budget{ 1000 };
+    // stop early after this many layouts, 0 = only the budget counts
+    std::uint64_t maxSamples{ 0 };
+};
+
+struct SampleHeatmap {
+    std::uint64_t samples{ 0 };
+    // attempts that ran into a dead end and were dropped
+    std::uint64_t rejected{ 0 };
+    // layouts with a part of a live plane / a plane head on each cell (y * size + x)
+    std::vector<std::uint32_t> occupied;
+    std::vector<std::uint32_t> heads;
+};
+
+// Approximate layout density for boards where exhaustive enumeration is out of reach (larger
+// than 10x10, or more planes). Draws random layouts consistent with the shots seen so far:
+// planes are put on the lowest uncovered hit first, backtracking over the placements that
+// could cover it, and the remaining planes go anywhere they fit. The draws are not exactly
+// uniform over layouts, but close enough to rank cells.
+//
+// The placements that fit the shots come from a CandidateTracker, pruned as shots are
+// recorded; sample() only draws from them.
+//
+// Every thread gets its own SplitMix64 stream of (seed, thread) and its own tallies, merged at
+// the end, so nothing is shared while sampling.
+class LayoutSampler {
+public:
+    // nodes one attempt may visit before it is dropped
+    static constexpr int MAX_STEPS = 512;
+
+    LayoutSampler(int boardSize, int planeCount);
+
+    void reset();
+    void record(int x, int y, bool hit, bool head);
+
+    int getBoardSize() const;
+    int getPlaneCount() const;
+
+    SampleHeatmap sample(const SamplerConfig& config) const;
+
+private:
+    enum class Seen : std::uint8_t {
+        Unknown,
+        Miss,
+        Hit,
+        Head
+    };
+
+    // Placements that fit the observation, and for every cell the ones covering it (CSR).
+    struct Candidates {
+        std::vector<int> allowed;
+        std::vector<int> coverStart;
+        std::vector<int> cover;
+    };
+
+    // rebuilds m_candidates from the tracker's live placements
+    void updateCandidates();
+    void sampleThread(const Candidates& candidates, SplitMix64 rng, std::chrono::steady_clock::time_point deadline,
+        std::uint64_t maxSamples, SampleHeatmap& heatmap) const;
+
+    int m_size;
+    int m_planeCount;
+    CandidateTracker m_tracker;
+    Candidates m_candidates;
+    std::vector<Seen> m_seen;
+    std::vector<int> m_hits;
+};
@@ -0,0 +1,154 @@
+#include "MatchDriver.h"
+#include "Ship.h"
+
+bool MoveSlot::deliver(const Move& move) const
+{
+    return m_driver && m_driver->deliver(move);
+}
+
+void MatchDriver::Task::FinalAwaiter::await_suspend(Handle handle) noexcept
+{
+    MatchDriver* driver = handle.promise().driver;
+    if (driver->m_onFinished)
+        driver->m_onFinished(driver->m_outcome);
+    // last touch: the owner may destroy the driver as soon as it sees this
+    driver->m_finished.store(true, std::memory_order_release);
+}
+
+void MatchDriver::MoveAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    driver.m_waiting = handle;
+    driver.m_awaiting.store(true, std::memory_order_release);
+    // the move may arrive, and the match move on, before request() returns: nothing after this
+    driver.m_sources[request.player]->request(request, MoveSlot(&driver));
+}
+
+MatchDriver::MatchDriver(std::unique_ptr<IGame> game, IMoveSource& first, IMoveSource& second, IExecutor& executor)
+    : m_game(std::move(game)), m_sources{ &first, &second }, m_executor(executor),
+    m_boardSize(m_game->getGridSize()), m_maxShips(m_game->getMaxShips()),
+    m_task(play())
+{
+    m_task.handle.promise().driver = this;
+}
+
+MatchDriver::~MatchDriver()
+{
+    m_sources[0]->cancel();
+    m_sources[1]->cancel();
+    if (m_task.handle)
+        m_task.handle.destroy();
+}
+
+void MatchDriver::setOnFinished(std::function<void(const MatchOutcome&)> onFinished)
+{
+    m_onFinished = std::move(onFinished);
+}
+
+void MatchDriver::start()
+{
+    m_executor.post(m_task.handle);
+}
+
+bool MatchDriver::isFinished() const
+{
+    return m_finished.load(std::memory_order_acquire);
+}
+
+const MatchOutcome& MatchDriver::getOutcome() const
+{
+    return m_outcome;
+}
+
+IGame& MatchDriver::getGame()
+{
+    return *m_game;
+}
+
+MatchDriver::Task MatchDriver::play()
+{
+    m_game->startGame();
+    for (int player = 0; player < 2; ++player)
+        m_sources[player]->onMatchStart(player, m_boardSize, m_maxShips);
+
+    const std::shared_ptr<IBoard> boards[2] = { m_game->getPlayer1()->getBoard(), m_game->getPlayer2()->getBoard() };
+
+    for (int player = 0; player < 2; ++player) {
+        while (boards[player]->getShipsCount() < m_maxShips) {
+            Move move = co_await nextMove(MoveRequest::Kind::Placement, player);
+            if (move.kind == Move::Kind::Resign) {
+                m_outcome.winner = player ^ 1;
+                co_return;
+            }
+            if (move.kind != Move::Kind::PlaceShip
+                || !m_game->placeShip(Position(move.x, move.y), Ship::PART_COUNT, move.orientation)) {
+                if (!reject(player, move)) {
+                    m_outcome.winner = player ^ 1;
+                    co_return;
+                }
+            }
+        }
+        m_game->switchTurn();
+    }
+
+    while (!m_game->isGameOver()) {
+        const int player = currentPlayer();
+        Move move = co_await nextMove(MoveRequest::Kind::Shot, player);
+        if (move.kind == Move::Kind::Resign) {
+            m_outcome.winner = player ^ 1;
+            co_return;
+        }
+
+        // the game would take a repeated shot as a miss and pass the turn
+        const Position target(move.x, move.y);
+        const IBoard& board = *boards[player ^ 1];
+        const bool inside = target.m_x >= 0 && target.m_x < m_boardSize && target.m_y >= 0 && target.m_y < m_boardSize;
+        const CellState state = inside ? board.getCellState(target) : CellState::Empty;
+        if (move.kind != Move::Kind::Shoot || !inside || state == CellState::Hit || state == CellState::Miss) {
+            if (!reject(player, move)) {
+                m_outcome.winner = player ^ 1;
+                co_return;
+            }
+            continue;
+        }
+
+        m_game->shoot(target);
+        ++m_outcome.shots;
+        m_sources[player]->onShotResult(board.getCellInfo(target));
+    }
+
+    m_outcome.completed = true;
+    m_outcome.winner = boards[1]->allShipsSunk() ? 0 : 1;
+}
+
+MatchDriver::MoveAwaiter MatchDriver::nextMove(MoveRequest::Kind kind, int player)
+{
+    MoveRequest request;
+    request.kind = kind;
+    request.player = player;
+    auto board = player == 0 ? m_game->getPlayer1()->getBoard() : m_game->getPlayer2()->getBoard();
+    request.placed = board->getShipsCount();
+    return MoveAwaiter{ *this, request };
+}
+
+bool MatchDriver::reject(int player, const Move& move)
+{
+    ++m_outcome.rejectedMoves;
+    m_sources[player]->onMoveRejected(move);
+    return ++m_rejected[player] < MAX_REJECTED_MOVES;
+}
+
+bool MatchDriver::deliver(const Move& move)
+{
+    bool expected = true;
+    if (!m_awaiting.compare_exchange_strong(expected, false, std::memory_order_acq_rel))
+        return false;
+
+    m_move = move;
+    m_executor.post(m_waiting);
+    return true;
+}
+
+int MatchDriver::currentPlayer() const
+{
+    return m_game->getCurrentPlayer().lock() == m_game->getPlayer2() ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include "IExecutor.h"
+#include "IGame.h"
+#include "IMoveSource.h"
+
+struct MatchOutcome {
+    bool completed{ false };            // false when a side resigned
+    int winner{ -1 };
+    int shots{ 0 };
+    int rejectedMoves{ 0 };             // both sides together; each side's own count decides resigning
+};
+
+// Plays one game as a C++20 coroutine: placement for player 1 then player 2, then shots until
+// the game is over. Every move is co_awaited from the side's IMoveSource, so a match waiting for
+// a human or a socket holds no thread; the executor resumes it once the move arrives. The game
+// is only touched from the coroutine, one resumption at a time, so it needs no lock.
+class MatchDriver {
+public:
+    // A side that breaks the rules this many times resigns.
+    static constexpr int MAX_REJECTED_MOVES = 1000;
+
+    MatchDriver(std::unique_ptr<IGame> game, IMoveSource& first, IMoveSource& second, IExecutor& executor);
+    // Cancels a pending request on either side. Do not destroy a driver while it is running.
+    ~MatchDriver();
+
+    MatchDriver(const MatchDriver&) = delete;
+    MatchDriver& operator=(const MatchDriver&) = delete;
+
+    // Runs on the executor thread just before the match counts as finished; must not destroy the driver.
+    void setOnFinished(std::function<void(const MatchOutcome&)> onFinished);
+
+    // Schedules the match on the executor.
+    void start();
+
+    bool isFinished() const;
+    // Valid once isFinished().
+    const MatchOutcome& getOutcome() const;
+    IGame& getGame();
+
+private:
+    friend class MoveSlot;
+
+    struct Task {
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(Handle handle) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        struct promise_type {
+            MatchDriver* driver{ nullptr };
+
+            Task get_return_object() { return Task{ Handle::from_promise(*this) }; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+
+        Handle handle;
+    };
+
+    struct MoveAwaiter {
+        MatchDriver& driver;
+        MoveRequest request;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        Move await_resume() const noexcept { return driver.m_move; }
+    };
+
+    Task play();
+    MoveAwaiter nextMove(MoveRequest::Kind kind, int player);
+    bool reject(int player, const Move& move);
+    bool deliver(const Move& move);
+    int currentPlayer() const;
+
+    std::unique_ptr<IGame> m_game;
+    IMoveSource* m_sources[2];
+    IExecutor& m_executor;
+    int m_boardSize;
+    int m_maxShips;
+    std::function<void(const MatchOutcome&)> m_onFinished;
+
+    Task m_task;
+    Move m_move;
+    std::coroutine_handle<> m_waiting;
+    std::atomic<bool> m_awaiting{ false };
+    MatchOutcome m_outcome;
+    int m_rejected[2]{};
+    std::atomic<bool> m_finished{ false };
+};
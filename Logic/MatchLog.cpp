@@ -0,0 +1,363 @@
+#include "MatchLog.h"
+#include "GameFactory.h"
+#include "IGame.h"
+#include "Ship.h"
+
+namespace
+{
+    constexpr std::uint8_t OP_MASK = 0x03;
+    constexpr int ARG_SHIFT = 2;
+    constexpr int PLAYER_SHIFT = 4;
+    constexpr int DELTA_SHIFT = 5;
+    constexpr std::uint8_t DELTA_VARINT = 3;
+    constexpr std::uint8_t RESERVED_BIT = 0x80;
+    constexpr int HIT_BIT = 1;
+    constexpr int HEAD_BIT = 2;
+
+    static_assert(GameFactory::MAX_BOARD_SIZE <= MatchLog::MAX_BOARD_SIZE, "every game's size fits the log header");
+
+    void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    bool readVarint(const std::vector<std::uint8_t>& in, std::size_t& offset, std::uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && offset < in.size(); shift += 7) {
+            std::uint8_t byte = in[offset++];
+            value |= std::uint64_t{ byte & 0x7Fu } << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    std::uint64_t zigzag(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    bool hasPosition(MatchOp op)
+    {
+        return op == MatchOp::PlaceShip || op == MatchOp::Shoot;
+    }
+
+    int currentPlayer(const IGame& game)
+    {
+        return game.getCurrentPlayer().lock() == game.getPlayer2() ? 1 : 0;
+    }
+}
+
+MatchLog::MatchLog(int boardSize, int maxShips)
+{
+    // a zero size marks the log invalid; load() never accepts one either
+    const bool valid = boardSize >= 1 && boardSize <= MAX_BOARD_SIZE && maxShips >= 0 && maxShips <= MAX_SHIPS;
+    m_bytes.reserve(HEADER_SIZE + 64);
+    m_bytes.push_back(VERSION);
+    m_bytes.push_back(valid ? static_cast<std::uint8_t>(boardSize) : 0);
+    m_bytes.push_back(valid ? static_cast<std::uint8_t>(maxShips) : 0);
+    m_bytes.push_back(0);
+}
+
+bool MatchLog::append(const MatchRecord& record)
+{
+    if (!isValid())
+        return false;
+    const int size = getBoardSize();
+    if (hasPosition(record.op) && (record.x < 0 || record.x >= size || record.y < 0 || record.y >= size))
+        return false;
+
+    std::uint8_t arg = 0;
+    switch (record.op) {
+    case MatchOp::PlaceShip:
+        arg = static_cast<std::uint8_t>(record.orientation);
+        break;
+    case MatchOp::Shoot:
+        arg = (record.hit ? HIT_BIT : 0) | (record.head ? HEAD_BIT : 0);
+        break;
+    case MatchOp::SwitchTurn:
+        break;
+    case MatchOp::StateChanged:
+        arg = static_cast<std::uint8_t>(record.state);
+        break;
+    }
+
+    const std::int64_t delta = static_cast<std::int64_t>(record.turnNumber) - m_lastTurnNumber;
+    const std::uint8_t deltaCode = delta >= 0 && delta < DELTA_VARINT ? static_cast<std::uint8_t>(delta) : DELTA_VARINT;
+
+    m_bytes.push_back(static_cast<std::uint8_t>(static_cast<std::uint8_t>(record.op)
+        | ((arg & 0x03) << ARG_SHIFT) | ((record.player & 1) << PLAYER_SHIFT) | (deltaCode << DELTA_SHIFT)));
+    if (deltaCode == DELTA_VARINT)
+        writeVarint(m_bytes, zigzag(delta));
+
+    if (hasPosition(record.op)) {
+        const int cell = record.y * size + record.x;
+        m_bytes.push_back(static_cast<std::uint8_t>(cell));
+        if (positionBytes() == 2)
+            m_bytes.push_back(static_cast<std::uint8_t>(cell >> 8));
+    }
+
+    m_lastTurnNumber = record.turnNumber;
+    ++m_records;
+    if (record.op != MatchOp::StateChanged)
+        ++m_plies;
+    return true;
+}
+
+bool MatchLog::load(const std::uint8_t* data, std::size_t size)
+{
+    if (!data || size < HEADER_SIZE || data[0] != VERSION || data[1] == 0 || data[3] != 0)
+        return false;
+
+    MatchLog loaded(data[1], data[2]);
+    loaded.m_bytes.assign(data, data + size);
+
+    Reader reader(loaded);
+    MatchRecord record;
+    while (reader.next(record)) {
+        loaded.m_lastTurnNumber = record.turnNumber;
+        ++loaded.m_records;
+        if (record.op != MatchOp::StateChanged)
+            ++loaded.m_plies;
+    }
+    if (reader.failed())
+        return false;
+
+    *this = std::move(loaded);
+    return true;
+}
+
+void MatchLog::clear()
+{
+    m_bytes.resize(HEADER_SIZE);
+    m_lastTurnNumber = 0;
+    m_records = 0;
+    m_plies = 0;
+}
+
+bool MatchLog::isValid() const
+{
+    return m_bytes[1] != 0;
+}
+
+const std::vector<std::uint8_t>& MatchLog::getBytes() const
+{
+    return m_bytes;
+}
+
+int MatchLog::getBoardSize() const
+{
+    return m_bytes[1];
+}
+
+int MatchLog::getMaxShips() const
+{
+    return m_bytes[2];
+}
+
+std::size_t MatchLog::getRecordCount() const
+{
+    return m_records;
+}
+
+std::size_t MatchLog::getPlyCount() const
+{
+    return m_plies;
+}
+
+std::size_t MatchLog::positionBytes() const
+{
+    return getBoardSize() <= 16 ? 1 : 2;
+}
+
+MatchLog::Reader::Reader(const MatchLog& log)
+    : m_log(log), m_offset(HEADER_SIZE)
+{
+}
+
+bool MatchLog::Reader::next(MatchRecord& record)
+{
+    const auto& bytes = m_log.m_bytes;
+    if (m_failed || m_offset >= bytes.size())
+        return false;
+
+    const std::uint8_t header = bytes[m_offset++];
+    if (header & RESERVED_BIT) {
+        m_failed = true;
+        return false;
+    }
+
+    record = MatchRecord{};
+    record.op = static_cast<MatchOp>(header & OP_MASK);
+    record.player = (header >> PLAYER_SHIFT) & 1;
+
+    const std::uint8_t arg = (header >> ARG_SHIFT) & 0x03;
+    switch (record.op) {
+    case MatchOp::PlaceShip:
+        record.orientation = static_cast<Orientation>(arg);
+        break;
+    case MatchOp::Shoot:
+        record.hit = arg & HIT_BIT;
+        record.head = arg & HEAD_BIT;
+        break;
+    case MatchOp::SwitchTurn:
+        break;
+    case MatchOp::StateChanged:
+        record.state = static_cast<GameState>(arg);
+        break;
+    }
+
+    std::int64_t delta = (header >> DELTA_SHIFT) & 0x03;
+    if (delta == DELTA_VARINT) {
+        std::uint64_t encoded;
+        if (!readVarint(bytes, m_offset, encoded)) {
+            m_failed = true;
+            return false;
+        }
+        delta = unzigzag(encoded);
+    }
+    m_turnNumber = static_cast<std::uint32_t>(m_turnNumber + delta);
+    record.turnNumber = m_turnNumber;
+
+    if (hasPosition(record.op)) {
+        const std::size_t width = m_log.positionBytes();
+        if (bytes.size() - m_offset < width) {
+            m_failed = true;
+            return false;
+        }
+        int cell = bytes[m_offset];
+        if (width == 2)
+            cell |= bytes[m_offset + 1] << 8;
+        m_offset += width;
+
+        const int size = m_log.getBoardSize();
+        if (cell >= size * size) {
+            m_failed = true;
+            return false;
+        }
+        record.x = cell % size;
+        record.y = cell / size;
+    }
+    return true;
+}
+
+MatchRecorder::MatchRecorder(IGame& game)
+    : m_bus(game.getEventBus()), m_cursor(m_bus.subscribe()),
+    m_log(game.getGridSize(), game.getMaxShips())
+{
+}
+
+std::size_t MatchRecorder::poll()
+{
+    return m_bus.drain(m_cursor, [this](const GameEvent& event) {
+        MatchRecord record;
+        record.player = event.player;
+        record.x = event.x;
+        record.y = event.y;
+        record.turnNumber = event.turnNumber;
+        switch (event.type) {
+        case GameEventType::ShipPlaced:
+            record.op = MatchOp::PlaceShip;
+            record.orientation = event.orientation;
+            break;
+        case GameEventType::ShotFired:
+            record.op = MatchOp::Shoot;
+            record.hit = event.cellState == CellState::Hit;
+            record.head = event.isHead;
+            break;
+        case GameEventType::TurnSwitched:
+            record.op = MatchOp::SwitchTurn;
+            break;
+        case GameEventType::StateChanged:
+            record.op = MatchOp::StateChanged;
+            record.state = event.state;
+            break;
+        }
+        if (!m_log.append(record))
+            ++m_skipped;
+    });
+}
+
+const MatchLog& MatchRecorder::getLog() const
+{
+    return m_log;
+}
+
+std::uint64_t MatchRecorder::getDropped() const
+{
+    return m_cursor.dropped;
+}
+
+std::uint64_t MatchRecorder::getSkipped() const
+{
+    return m_skipped;
+}
+
+namespace MatchReplay
+{
+    std::unique_ptr<IGame> replay(const MatchLog& log, std::size_t plies)
+    {
+        if (!log.isValid())
+            return nullptr;
+        GameFactory factory("Player1", "Player2", log.getBoardSize(), log.getMaxShips());
+        std::unique_ptr<IGame> game = factory.create();
+        // what the game reported for each shot; a repeated shot counts as a miss on a hit cell
+        EventBus& bus = game->getEventBus();
+        EventCursor shots = bus.subscribe(eventMask(GameEventType::ShotFired));
+
+        MatchLog::Reader reader(log);
+        MatchRecord record;
+        std::size_t applied = 0;
+        while (reader.next(record)) {
+            const bool restart = record.op == MatchOp::StateChanged && record.state == GameState::PlacingShips;
+            if (record.op == MatchOp::StateChanged && !restart) {
+                if (game->getState() != record.state)
+                    return nullptr;
+                continue;
+            }
+            if (applied == plies)
+                break;
+
+            switch (record.op) {
+            case MatchOp::PlaceShip:
+                if (currentPlayer(*game) != record.player
+                    || !game->placeShip(Position(record.x, record.y), Ship::PART_COUNT, record.orientation))
+                    return nullptr;
+                break;
+            case MatchOp::Shoot:
+            {
+                if (currentPlayer(*game) != record.player)
+                    return nullptr;
+                game->shoot(Position(record.x, record.y));
+                GameEvent shot;
+                if (bus.drain(shots, [&shot](const GameEvent& event) { shot = event; }) != 1)
+                    return nullptr;
+                if (shot.cellState != (record.hit ? CellState::Hit : CellState::Miss) || record.head != (record.hit && shot.isHead))
+                    return nullptr;
+                break;
+            }
+            case MatchOp::SwitchTurn:
+                game->switchTurn();
+                break;
+            case MatchOp::StateChanged:
+                game->startGame();
+                continue;
+            }
+            ++applied;
+        }
+
+        if (reader.failed())
+            return nullptr;
+        return game;
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "EventBus.h"
+#include "GameEvent.h"
+#include "GameState.h"
+#include "Orientation.h"
+
+class IGame;
+
+enum class MatchOp : std::uint8_t {
+    PlaceShip,
+    Shoot,
+    SwitchTurn,
+    StateChanged
+};
+
+struct MatchRecord {
+    MatchOp op{ MatchOp::StateChanged };
+    std::uint8_t player{ 0 };
+    int x{ 0 };                         // PlaceShip: plane head, Shoot: target cell
+    int y{ 0 };
+    Orientation orientation{ Orientation::Up };   // PlaceShip
+    bool hit{ false };                            // Shoot
+    bool head{ false };                           // Shoot
+    GameState state{ GameState::PlacingShips };   // StateChanged
+    std::uint32_t turnNumber{ 0 };
+};
+
+// Append-only binary log of one match.
+//
+// Header (4 bytes): format version, board size, max planes, reserved.
+// Every record starts with one byte:
+//   bits 0-1  MatchOp
+//   bits 2-3  orientation (PlaceShip), GameState (StateChanged), hit and head (Shoot)
+//   bit  4    player
+//   bits 5-6  turn number minus the previous record's, 3 = zigzag varint follows
+//   bit  7    reserved, zero
+// PlaceShip and Shoot add the cell y * size + x: one byte up to 16x16, two bytes above.
+// A placement is 2 bytes, a shot and the state change after it 3 bytes together.
+// Positions off the board have no cell, so records carrying one are not logged.
+class MatchLog {
+public:
+    static constexpr std::uint8_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 4;
+    // board size and plane count each take one header byte
+    static constexpr int MAX_BOARD_SIZE = 255;
+    static constexpr int MAX_SHIPS = 255;
+
+    // Walks the records of a log in order.
+    class Reader {
+    public:
+        explicit Reader(const MatchLog& log);
+
+        // False at the end of the log or on a malformed record; failed() tells them apart.
+        bool next(MatchRecord& record);
+        bool failed() const { return m_failed; }
+
+    private:
+        const MatchLog& m_log;
+        std::size_t m_offset;
+        std::uint32_t m_turnNumber{ 0 };
+        bool m_failed{ false };
+    };
+
+    // A size outside 1..MAX_BOARD_SIZE or a plane count outside 0..MAX_SHIPS makes an invalid
+    // log that takes no records.
+    explicit MatchLog(int boardSize = 10, int maxShips = 3);
+
+    // False, logging nothing, on an invalid log or a PlaceShip or Shoot off the board.
+    bool append(const MatchRecord& record);
+
+    // Replaces the log with a copy of data; returns false, leaving the log untouched, if it does not decode.
+    bool load(const std::uint8_t* data, std::size_t size);
+
+    void clear();
+
+    bool isValid() const;
+
+    const std::vector<std::uint8_t>& getBytes() const;
+    int getBoardSize() const;
+    int getMaxShips() const;
+    std::size_t getRecordCount() const;
+    // PlaceShip, Shoot and SwitchTurn records; state changes follow from them.
+    std::size_t getPlyCount() const;
+
+private:
+    std::size_t positionBytes() const;
+
+    std::vector<std::uint8_t> m_bytes;
+    std::uint32_t m_lastTurnNumber{ 0 };
+    std::size_t m_records{ 0 };
+    std::size_t m_plies{ 0 };
+};
+
+// Appends what a game publishes on its EventBus to a MatchLog. Call poll() at least once
+// every EventBus capacity events; anything overwritten before that is counted in getDropped().
+class MatchRecorder {
+public:
+    explicit MatchRecorder(IGame& game);
+
+    // Records the events published since the last call and returns how many.
+    std::size_t poll();
+
+    const MatchLog& getLog() const;
+    std::uint64_t getDropped() const;
+    // Events the log could not hold, such as shots fired off the board. A replay of the log
+    // fails once the game no longer follows it.
+    std::uint64_t getSkipped() const;
+
+private:
+    EventBus& m_bus;
+    EventCursor m_cursor;
+    MatchLog m_log;
+    std::uint64_t m_skipped{ 0 };
+};
+
+namespace MatchReplay
+{
+    inline constexpr std::size_t ALL_PLIES = std::numeric_limits<std::size_t>::max();
+
+    // Rebuilds the game after the first `plies` plies of the log on a fresh game without listeners.
+    // Every recorded shot result, as the game reports it, and state change is checked on the
+    // way; returns nullptr when the log is malformed or the game does not follow it.
+    std::unique_ptr<IGame> replay(const MatchLog& log, std::size_t plies = ALL_PLIES);
+}
@@ -0,0 +1,116 @@
+#include "MoveSources.h"
+#include "DynamicBoard.h"
+
+BotMoveSource::BotMoveSource(std::unique_ptr<IPlacementStrategy> placement,
+    std::unique_ptr<IShootingStrategy> shooter, std::uint64_t seed)
+    : m_placement(std::move(placement)), m_shooter(std::move(shooter)), m_rng{ seed }
+{
+}
+
+void BotMoveSource::onMatchStart(int, int boardSize, int maxShips)
+{
+    m_boardSize = boardSize;
+    m_maxShips = maxShips;
+    m_fleet.clear();
+    if (m_shooter)
+        m_shooter->reset(boardSize);
+}
+
+void BotMoveSource::request(const MoveRequest& request, MoveSlot slot)
+{
+    Move move;
+    if (request.kind == MoveRequest::Kind::Placement) {
+        if (request.placed == 0 && !planFleet())
+            m_fleet.clear();
+        if (request.placed < static_cast<int>(m_fleet.size())) {
+            const Ship& plane = m_fleet[request.placed];
+            move.kind = Move::Kind::PlaceShip;
+            move.x = static_cast<std::int16_t>(plane.getHead().m_x);
+            move.y = static_cast<std::int16_t>(plane.getHead().m_y);
+            move.orientation = plane.getOrientation();
+        }
+    }
+    else if (m_shooter) {
+        Position target = m_shooter->nextShot(m_rng);
+        if (target.m_x >= 0) {
+            move.kind = Move::Kind::Shoot;
+            move.x = static_cast<std::int16_t>(target.m_x);
+            move.y = static_cast<std::int16_t>(target.m_y);
+        }
+    }
+    // anything left as Resign: out of planes or out of shots
+    slot.deliver(move);
+}
+
+void BotMoveSource::onShotResult(const Cell& cell)
+{
+    if (m_shooter)
+        m_shooter->onShotResult(cell);
+}
+
+bool BotMoveSource::planFleet()
+{
+    m_fleet.clear();
+    if (!m_placement)
+        return false;
+
+    DynamicBoard scratch(m_boardSize);
+    auto tryPlace = [this, &scratch](const Ship& plane) {
+        if (!scratch.placeShip(plane))
+            return false;
+        m_fleet.push_back(plane);
+        return true;
+    };
+    return m_placement->placeShips(m_boardSize, m_maxShips, tryPlace, m_rng);
+}
+
+void InputMoveSource::onMatchStart(int, int, int)
+{
+    m_rejected.store(0, std::memory_order_relaxed);
+}
+
+void InputMoveSource::request(const MoveRequest& request, MoveSlot slot)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_request = request;
+    m_slot = slot;
+}
+
+void InputMoveSource::onMoveRejected(const Move&)
+{
+    m_rejected.fetch_add(1, std::memory_order_relaxed);
+}
+
+void InputMoveSource::cancel()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slot = MoveSlot();
+}
+
+bool InputMoveSource::submit(const Move& move)
+{
+    // delivered under the lock so cancel() cannot let the match go away halfway through
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_slot)
+        return false;
+    MoveSlot slot = m_slot;
+    m_slot = MoveSlot();
+    return slot.deliver(move);
+}
+
+bool InputMoveSource::isWaiting() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<bool>(m_slot);
+}
+
+MoveRequest InputMoveSource::getRequest() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_request;
+}
+
+std::size_t InputMoveSource::getRejectedCount() const
+{
+    return m_rejected.load(std::memory_order_relaxed);
+}
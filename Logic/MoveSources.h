@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "IMoveSource.h"
+#include "IPlacementStrategy.h"
+#include "IShootingStrategy.h"
+#include "Ship.h"
+#include "SplitMix64.h"
+
+// Strategies answering on the executor thread that runs the match, so bot turns never
+// wait on anything.
+class BotMoveSource : public IMoveSource {
+public:
+    BotMoveSource(std::unique_ptr<IPlacementStrategy> placement,
+        std::unique_ptr<IShootingStrategy> shooter, std::uint64_t seed);
+
+    void onMatchStart(int player, int boardSize, int maxShips) override;
+    void request(const MoveRequest& request, MoveSlot slot) override;
+    void onShotResult(const Cell& cell) override;
+
+private:
+    // Lays out the whole fleet on a scratch board the first time a plane is asked for.
+    bool planFleet();
+
+    std::unique_ptr<IPlacementStrategy> m_placement;
+    std::unique_ptr<IShootingStrategy> m_shooter;
+    SplitMix64 m_rng;
+    int m_boardSize{ 0 };
+    int m_maxShips{ 0 };
+    std::vector<Ship> m_fleet;
+};
+
+// Moves pushed in from outside: UI clicks or a connection reader call submit() from their own
+// thread whenever the player acts.
+class InputMoveSource : public IMoveSource {
+public:
+    void onMatchStart(int player, int boardSize, int maxShips) override;
+    void request(const MoveRequest& request, MoveSlot slot) override;
+    void onMoveRejected(const Move& move) override;
+    void cancel() override;
+
+    // Any thread. False when the match is not waiting on this side.
+    bool submit(const Move& move);
+
+    bool isWaiting() const;
+    MoveRequest getRequest() const;
+    std::size_t getRejectedCount() const;
+
+private:
+    mutable std::mutex m_mutex;
+    MoveSlot m_slot;
+    MoveRequest m_request;
+    std::atomic<std::size_t> m_rejected{ 0 };
+};
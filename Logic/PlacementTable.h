@@ -0,0 +1,127 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "BitMask.h"
+#include "Orientation.h"
+
+// Every in-bounds (head, orientation) plane placement on the classic 10x10 board,
+// generated at compile time.
+namespace PlacementTable
+{
+	inline constexpr int BOARD_SIZE = 10;
+	inline constexpr int CELL_COUNT = BOARD_SIZE * BOARD_SIZE;
+	inline constexpr int PART_COUNT = 10;
+	inline constexpr int ORIENTATION_COUNT = 4;
+
+	struct Offset {
+		int x{ 0 };
+		int y{ 0 };
+	};
+
+	// Plane shape for Orientation::Up, head first.
+	inline constexpr Offset BASE_OFFSETS[PART_COUNT] = {
+		{0, 0},
+		{-2, 1}, {-1, 1}, {0, 1}, {1, 1}, {2, 1},
+		{0, 2},
+		{-1, 3}, {0, 3}, {1, 3}
+	};
+
+	constexpr Offset rotate(const Offset& offset, Orientation orientation)
+	{
+		switch (orientation) {
+		case Orientation::Up:    return offset;
+		case Orientation::Down:  return { offset.x, -offset.y };
+		case Orientation::Left:  return { offset.y, -offset.x };
+		case Orientation::Right: return { -offset.y, offset.x };
+		}
+		return offset;
+	}
+
+	constexpr std::array<std::array<Offset, PART_COUNT>, ORIENTATION_COUNT> buildOffsets()
+	{
+		std::array<std::array<Offset, PART_COUNT>, ORIENTATION_COUNT> offsets{};
+		for (int o = 0; o < ORIENTATION_COUNT; ++o)
+			for (int i = 0; i < PART_COUNT; ++i)
+				offsets[o][i] = rotate(BASE_OFFSETS[i], static_cast<Orientation>(o));
+		return offsets;
+	}
+
+	// Part offsets relative to the head, indexed by [orientation][part].
+	inline constexpr auto OFFSETS = buildOffsets();
+
+	struct Placement {
+		BitMask128 mask;
+		std::uint8_t head{ 0 };
+		Orientation orientation{ Orientation::Up };
+		std::array<std::uint8_t, PART_COUNT> cells{};
+	};
+
+	constexpr bool fits(int x, int y, int orientation)
+	{
+		for (const auto& offset : OFFSETS[orientation]) {
+			int px = x + offset.x;
+			int py = y + offset.y;
+			if (px < 0 || px >= BOARD_SIZE || py < 0 || py >= BOARD_SIZE)
+				return false;
+		}
+		return true;
+	}
+
+	constexpr int countPlacements()
+	{
+		int count = 0;
+		for (int cell = 0; cell < CELL_COUNT; ++cell)
+			for (int o = 0; o < ORIENTATION_COUNT; ++o)
+				if (fits(cell % BOARD_SIZE, cell / BOARD_SIZE, o))
+					++count;
+		return count;
+	}
+
+	inline constexpr int COUNT = countPlacements();
+
+	constexpr std::array<Placement, COUNT> buildPlacements()
+	{
+		std::array<Placement, COUNT> placements{};
+		int next = 0;
+		for (int cell = 0; cell < CELL_COUNT; ++cell) {
+			int x = cell % BOARD_SIZE;
+			int y = cell / BOARD_SIZE;
+			for (int o = 0; o < ORIENTATION_COUNT; ++o) {
+				if (!fits(x, y, o))
+					continue;
+				Placement& placement = placements[next++];
+				placement.head = static_cast<std::uint8_t>(cell);
+				placement.orientation = static_cast<Orientation>(o);
+				for (int i = 0; i < PART_COUNT; ++i) {
+					int partCell = (y + OFFSETS[o][i].y) * BOARD_SIZE + (x + OFFSETS[o][i].x);
+					placement.cells[i] = static_cast<std::uint8_t>(partCell);
+					placement.mask.set(partCell);
+				}
+			}
+		}
+		return placements;
+	}
+
+	inline constexpr auto PLACEMENTS = buildPlacements();
+
+	constexpr std::array<std::int16_t, CELL_COUNT * ORIENTATION_COUNT> buildIndex()
+	{
+		std::array<std::int16_t, CELL_COUNT * ORIENTATION_COUNT> index{};
+		for (auto& entry : index)
+			entry = -1;
+		for (int i = 0; i < COUNT; ++i)
+			index[PLACEMENTS[i].head * ORIENTATION_COUNT + static_cast<int>(PLACEMENTS[i].orientation)] = static_cast<std::int16_t>(i);
+		return index;
+	}
+
+	// Placement id for [head cell * 4 + orientation], -1 when the plane leaves the board.
+	inline constexpr auto INDEX = buildIndex();
+
+	constexpr const Placement* find(int x, int y, Orientation orientation)
+	{
+		if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE)
+			return nullptr;
+		int id = INDEX[(y * BOARD_SIZE + x) * ORIENTATION_COUNT + static_cast<int>(orientation)];
+		return id < 0 ? nullptr : &PLACEMENTS[id];
+	}
+}
@@ -0,0 +1,183 @@
+#include "Protocol.h"
+
+namespace
+{
+    constexpr std::uint8_t HIT_BIT = 0x01;
+    constexpr std::uint8_t HEAD_BIT = 0x02;
+    constexpr int PLAYER_SHIFT = 2;
+    constexpr int STATE_SHIFT = 3;
+    constexpr std::uint8_t STATE_MASK = 0x03;
+    constexpr std::uint8_t RESERVED_BITS = 0xE0;
+    constexpr std::uint8_t LAST_ORIENTATION = static_cast<std::uint8_t>(Orientation::Right);
+    constexpr std::uint8_t LAST_STATE = static_cast<std::uint8_t>(GameState::GameOver);
+    constexpr std::uint8_t LAST_ERROR = static_cast<std::uint8_t>(Protocol::ErrorCode::AlreadyShot);
+}
+
+namespace Protocol
+{
+    int payloadSize(FrameType type)
+    {
+        switch (type) {
+        case FrameType::NewMatch: return 8;
+        case FrameType::PlaceShip: return 3;
+        case FrameType::Shoot: return 2;
+        case FrameType::Quit: return 0;
+        case FrameType::MatchStarted: return 2;
+        case FrameType::ShipPlaced: return 4;
+        case FrameType::ShotFired: return 3;
+        case FrameType::StateChanged: return 1;
+        case FrameType::Error: return 2;
+        case FrameType::Bye: return 0;
+        }
+        return -1;
+    }
+
+    void encode(const Frame& frame, std::vector<std::uint8_t>& out)
+    {
+        out.push_back(static_cast<std::uint8_t>(1 + payloadSize(frame.type)));
+        out.push_back(static_cast<std::uint8_t>(frame.type));
+
+        switch (frame.type) {
+        case FrameType::NewMatch:
+            for (int shift = 0; shift < 64; shift += 8)
+                out.push_back(static_cast<std::uint8_t>(frame.seed >> shift));
+            break;
+        case FrameType::PlaceShip:
+            out.insert(out.end(), { frame.x, frame.y, static_cast<std::uint8_t>(frame.orientation) });
+            break;
+        case FrameType::Shoot:
+            out.insert(out.end(), { frame.x, frame.y });
+            break;
+        case FrameType::MatchStarted:
+            out.insert(out.end(), { frame.boardSize, frame.count });
+            break;
+        case FrameType::ShipPlaced:
+            out.insert(out.end(), { frame.x, frame.y, static_cast<std::uint8_t>(frame.orientation), frame.count });
+            break;
+        case FrameType::ShotFired: {
+            std::uint8_t flags = (frame.hit ? HIT_BIT : 0) | (frame.head ? HEAD_BIT : 0)
+                | ((frame.player & 1) << PLAYER_SHIFT) | (static_cast<std::uint8_t>(frame.state) << STATE_SHIFT);
+            out.insert(out.end(), { frame.x, frame.y, flags });
+            break;
+        }
+        case FrameType::StateChanged:
+            out.push_back(static_cast<std::uint8_t>(frame.state));
+            break;
+        case FrameType::Error:
+            out.insert(out.end(), { static_cast<std::uint8_t>(frame.error), static_cast<std::uint8_t>(frame.rejected) });
+            break;
+        case FrameType::Quit:
+        case FrameType::Bye:
+            break;
+        }
+    }
+
+    DecodeResult decode(const std::uint8_t* data, std::size_t size, Frame& frame, std::size_t& consumed)
+    {
+        if (size == 0)
+            return DecodeResult::NeedMore;
+        if (data[0] == 0) {
+            consumed = 1;
+            return DecodeResult::Malformed;
+        }
+        if (size < 1u + data[0])
+            return DecodeResult::NeedMore;
+
+        consumed = 1u + data[0];
+        const std::uint8_t* payload = data + HEADER_SIZE;
+        const FrameType type = static_cast<FrameType>(data[1]);
+        const int expected = payloadSize(type);
+        frame = Frame();
+        frame.type = type;
+        if (expected < 0)
+            return DecodeResult::UnknownType;
+        if (data[0] != 1 + expected)
+            return DecodeResult::Malformed;
+
+        switch (type) {
+        case FrameType::NewMatch:
+            for (int i = 7; i >= 0; --i)
+                frame.seed = (frame.seed << 8) | payload[i];
+            break;
+        case FrameType::PlaceShip:
+        case FrameType::ShipPlaced:
+            if (payload[2] > LAST_ORIENTATION)
+                return DecodeResult::Malformed;
+            frame.x = payload[0];
+            frame.y = payload[1];
+            frame.orientation = static_cast<Orientation>(payload[2]);
+            if (type == FrameType::ShipPlaced)
+                frame.count = payload[3];
+            break;
+        case FrameType::Shoot:
+            frame.x = payload[0];
+            frame.y = payload[1];
+            break;
+        case FrameType::MatchStarted:
+            frame.boardSize = payload[0];
+            frame.count = payload[1];
+            break;
+        case FrameType::ShotFired:
+            if (payload[2] & RESERVED_BITS)
+                return DecodeResult::Malformed;
+            frame.x = payload[0];
+            frame.y = payload[1];
+            frame.hit = payload[2] & HIT_BIT;
+            frame.head = payload[2] & HEAD_BIT;
+            frame.player = (payload[2] >> PLAYER_SHIFT) & 1;
+            frame.state = static_cast<GameState>((payload[2] >> STATE_SHIFT) & STATE_MASK);
+            break;
+        case FrameType::StateChanged:
+            if (payload[0] > LAST_STATE)
+                return DecodeResult::Malformed;
+            frame.state = static_cast<GameState>(payload[0]);
+            break;
+        case FrameType::Error:
+            if (payload[0] > LAST_ERROR)
+                return DecodeResult::Malformed;
+            frame.error = static_cast<ErrorCode>(payload[0]);
+            frame.rejected = static_cast<FrameType>(payload[1]);
+            break;
+        case FrameType::Quit:
+        case FrameType::Bye:
+            break;
+        }
+        return DecodeResult::Ok;
+    }
+
+    Frame newMatch(std::uint64_t seed)
+    {
+        Frame frame;
+        frame.type = FrameType::NewMatch;
+        frame.seed = seed;
+        return frame;
+    }
+
+    Frame placeShip(int x, int y, Orientation orientation)
+    {
+        Frame frame;
+        frame.type = FrameType::PlaceShip;
+        frame.x = static_cast<std::uint8_t>(x);
+        frame.y = static_cast<std::uint8_t>(y);
+        frame.orientation = orientation;
+        return frame;
+    }
+
+    Frame shoot(int x, int y)
+    {
+        Frame frame;
+        frame.type = FrameType::Shoot;
+        frame.x = static_cast<std::uint8_t>(x);
+        frame.y = static_cast<std::uint8_t>(y);
+        return frame;
+    }
+
+    Frame error(ErrorCode code, FrameType rejected)
+    {
+        Frame frame;
+        frame.type = FrameType::Error;
+        frame.error = code;
+        frame.rejected = rejected;
+        return frame;
+    }
+}
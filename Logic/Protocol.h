@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameState.h"
+#include "Orientation.h"
+
+// Binary wire protocol for remote play. Every frame is
+//   [length][type][payload]
+// where length counts the type byte and the payload, and every type has a fixed payload:
+//
+//   client -> server                        server -> client
+//   NewMatch      seed (8, little endian)   MatchStarted  board size, planes
+//   PlaceShip     x, y, orientation         ShipPlaced    x, y, orientation, planes placed
+//   Shoot         x, y                      ShotFired     x, y, flags
+//   Quit          -                         StateChanged  GameState
+//                                           Error         ErrorCode, offending frame type
+//                                           Bye           -
+//
+// ShotFired flags: bit 0 hit, bit 1 head, bit 2 shooter (0 = first player), bits 3-4 the
+// GameState after the shot. A shot result is 5 bytes on the wire. Frames carry no request id:
+// a client may pipeline any number of commands and the replies come back in the same order.
+namespace Protocol
+{
+    inline constexpr std::size_t HEADER_SIZE = 2;
+    inline constexpr std::size_t MAX_FRAME_SIZE = HEADER_SIZE + 8;
+
+    enum class FrameType : std::uint8_t {
+        NewMatch = 0x01,
+        PlaceShip = 0x02,
+        Shoot = 0x03,
+        Quit = 0x04,
+
+        MatchStarted = 0x81,
+        ShipPlaced = 0x82,
+        ShotFired = 0x83,
+        StateChanged = 0x84,
+        Error = 0x85,
+        Bye = 0x86
+    };
+
+    enum class ErrorCode : std::uint8_t {
+        Malformed,
+        UnknownType,
+        NotPlacing,
+        CannotPlace,
+        NotPlaying,
+        OutsideBoard,
+        AlreadyShot
+    };
+
+    struct Frame {
+        FrameType type{ FrameType::Quit };
+        std::uint64_t seed{ 0 };                        // NewMatch
+        std::uint8_t x{ 0 };                            // PlaceShip, Shoot, ShipPlaced, ShotFired
+        std::uint8_t y{ 0 };
+        Orientation orientation{ Orientation::Up };     // PlaceShip, ShipPlaced
+        std::uint8_t count{ 0 };                        // MatchStarted: planes, ShipPlaced: placed
+        std::uint8_t boardSize{ 0 };                    // MatchStarted
+        std::uint8_t player{ 0 };                       // ShotFired
+        bool hit{ false };                              // ShotFired
+        bool head{ false };                             // ShotFired
+        GameState state{ GameState::PlacingShips };     // ShotFired, StateChanged
+        ErrorCode error{ ErrorCode::Malformed };        // Error
+        FrameType rejected{ FrameType::Quit };          // Error
+    };
+
+    enum class DecodeResult {
+        Ok,
+        NeedMore,
+        // the frame is skipped (consumed is set), the stream stays in sync
+        Malformed,
+        UnknownType
+    };
+
+    // Payload size of a known type, -1 for anything else.
+    int payloadSize(FrameType type);
+
+    // Appends the encoded frame to out.
+    void encode(const Frame& frame, std::vector<std::uint8_t>& out);
+
+    // Decodes the frame at the front of data. consumed is the frame's size for every result
+    // but NeedMore.
+    DecodeResult decode(const std::uint8_t* data, std::size_t size, Frame& frame, std::size_t& consumed);
+
+    Frame newMatch(std::uint64_t seed);
+    Frame placeShip(int x, int y, Orientation orientation);
+    Frame shoot(int x, int y);
+    Frame error(ErrorCode code, FrameType rejected);
+}
@@ -0,0 +1,105 @@
+#include "RandomStrategies.h"
+#include "Orientation.h"
+#include "Ship.h"
+
+bool RandomPlacement::placeShips(int boardSize, int maxShips,
+    const std::function<bool(const Ship&)>& tryPlace, SplitMix64& rng)
+{
+    int placed = 0;
+    for (int attempt = 0; attempt < ATTEMPTS_PER_SHIP * maxShips && placed < maxShips; ++attempt) {
+        Position head(rng.nextInt(boardSize), rng.nextInt(boardSize));
+        auto orientation = static_cast<Orientation>(rng.nextInt(4));
+        if (tryPlace(Ship(head, orientation)))
+            ++placed;
+    }
+    return placed == maxShips;
+}
+
+void RandomShooter::reset(int boardSize)
+{
+    m_size = boardSize;
+    m_remaining.resize(boardSize * boardSize);
+    for (int cell = 0; cell < boardSize * boardSize; ++cell)
+        m_remaining[cell] = cell;
+}
+
+Position RandomShooter::nextShot(SplitMix64& rng)
+{
+    if (m_remaining.empty())
+        return Position(-1, -1);
+
+    int pick = rng.nextInt(static_cast<int>(m_remaining.size()));
+    int cell = m_remaining[pick];
+    m_remaining[pick] = m_remaining.back();
+    m_remaining.pop_back();
+    return Position(cell % m_size, cell / m_size);
+}
+
+void RandomShooter::onShotResult(const Cell& /*cell*/)
+{
+}
+
+void HuntShooter::reset(int boardSize)
+{
+    m_size = boardSize;
+    m_remaining.resize(boardSize * boardSize);
+    m_slot.resize(boardSize * boardSize);
+    for (int cell = 0; cell < boardSize * boardSize; ++cell) {
+        m_remaining[cell] = cell;
+        m_slot[cell] = cell;
+    }
+    m_targets.clear();
+}
+
+Position HuntShooter::nextShot(SplitMix64& rng)
+{
+    while (!m_targets.empty()) {
+        int cell = m_targets.back();
+        m_targets.pop_back();
+        if (isOpen(cell)) {
+            take(cell);
+            return Position(cell % m_size, cell / m_size);
+        }
+    }
+
+    if (m_remaining.empty())
+        return Position(-1, -1);
+
+    int cell = m_remaining[rng.nextInt(static_cast<int>(m_remaining.size()))];
+    take(cell);
+    return Position(cell % m_size, cell / m_size);
+}
+
+void HuntShooter::onShotResult(const Cell& cell)
+{
+    if (cell.state != CellState::Hit)
+        return;
+
+    // a head hit brings the whole plane down, the rest of it is not worth chasing
+    if (cell.isHead) {
+        m_targets.clear();
+        return;
+    }
+
+    const int x = cell.position.m_x;
+    const int y = cell.position.m_y;
+    if (x > 0) m_targets.push_back(y * m_size + x - 1);
+    if (x + 1 < m_size) m_targets.push_back(y * m_size + x + 1);
+    if (y > 0) m_targets.push_back((y - 1) * m_size + x);
+    if (y + 1 < m_size) m_targets.push_back((y + 1) * m_size + x);
+}
+
+void HuntShooter::take(int cell)
+{
+    int slot = m_slot[cell];
+    int last = m_remaining.back();
+    m_remaining[slot] = last;
+    m_slot[last] = slot;
+    m_remaining.pop_back();
+    m_slot[cell] = -1;
+}
+
+bool HuntShooter::isOpen(int cell) const
+{
+    return m_slot[cell] >= 0;
+}
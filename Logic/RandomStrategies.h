@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "IPlacementStrategy.h"
+#include "IShootingStrategy.h"
+
+// Drops planes at random heads and orientations until the board holds maxShips of them.
+class RandomPlacement : public IPlacementStrategy {
+public:
+    static constexpr int ATTEMPTS_PER_SHIP = 1000;
+
+    bool placeShips(int boardSize, int maxShips,
+        const std::function<bool(const Ship&)>& tryPlace, SplitMix64& rng) override;
+};
+
+// Fires at every cell exactly once, in random order.
+class RandomShooter : public IShootingStrategy {
+public:
+    void reset(int boardSize) override;
+    Position nextShot(SplitMix64& rng) override;
+    void onShotResult(const Cell& cell) override;
+
+private:
+    int m_size{ 0 };
+    std::vector<int> m_remaining;
+};
+
+// Random shots until something is hit, then works through the neighbours of the hit cells.
+class HuntShooter : public IShootingStrategy {
+public:
+    void reset(int boardSize) override;
+    Position nextShot(SplitMix64& rng) override;
+    void onShotResult(const Cell& cell) override;
+
+private:
+    void take(int cell);
+    bool isOpen(int cell) const;
+
+    int m_size{ 0 };
+    std::vector<int> m_remaining;
+    // position of each cell in m_remaining, -1 once fired at
+    std::vector<int> m_slot;
+    std::vector<int> m_targets;
+};
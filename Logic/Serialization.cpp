@@ -0,0 +1,144 @@
+#include "Serialization.h"
+#include <algorithm>
+#include "PlacementTable.h"
+
+namespace
+{
+	constexpr int PLANES_OFFSET = 2;
+	constexpr int SHOTS_OFFSET = PLANES_OFFSET + Serialization::MAX_PLANES;
+	constexpr int SHOT_BYTES = (PlacementTable::CELL_COUNT + 7) / 8;
+
+	static_assert(PlacementTable::COUNT <= 0xFF, "placement ids are stored in one byte");
+	static_assert(SHOTS_OFFSET + SHOT_BYTES <= Serialization::BOARD_BLOB_SIZE, "board blob overflow");
+
+	void writeShotMask(const BitMask128& mask, std::uint8_t* out)
+	{
+		for (int i = 0; i < SHOT_BYTES; ++i)
+			out[i] = static_cast<std::uint8_t>(mask.words[i >> 3] >> ((i & 7) * 8));
+	}
+
+	BitMask128 readShotMask(const std::uint8_t* in)
+	{
+		BitMask128 mask;
+		for (int i = 0; i < SHOT_BYTES; ++i)
+			mask.words[i >> 3] |= std::uint64_t{ in[i] } << ((i & 7) * 8);
+		return mask;
+	}
+
+	// Everything decodeBoard checks, so a board is only touched once the whole blob is known good.
+	bool isValid(const Serialization::BoardBlob& blob)
+	{
+		if (blob[0] != Serialization::VERSION || blob[1] > Serialization::MAX_PLANES)
+			return false;
+
+		const BitMask128 shots = readShotMask(blob.data() + SHOTS_OFFSET);
+		if (shots.words[1] >> (PlacementTable::CELL_COUNT - 64))
+			return false;
+
+		BitMask128 covered;
+		for (int i = 0; i < blob[1]; ++i) {
+			const int id = blob[PLANES_OFFSET + i];
+			if (id >= PlacementTable::COUNT || (covered & PlacementTable::PLACEMENTS[id].mask).any())
+				return false;
+			covered |= PlacementTable::PLACEMENTS[id].mask;
+		}
+		return true;
+	}
+
+	// blob must be valid
+	void load(const Serialization::BoardBlob& blob, Board& board)
+	{
+		board.resetBoard();
+		for (int i = 0; i < blob[1]; ++i) {
+			const auto& placement = PlacementTable::PLACEMENTS[blob[PLANES_OFFSET + i]];
+			Position head(placement.head % PlacementTable::BOARD_SIZE, placement.head / PlacementTable::BOARD_SIZE);
+			board.placeShip(Ship(head, placement.orientation));
+		}
+
+		readShotMask(blob.data() + SHOTS_OFFSET).forEachBit([&board](int cell) {
+			board.receiveShot(Position(cell % PlacementTable::BOARD_SIZE, cell / PlacementTable::BOARD_SIZE));
+		});
+		board.clearJournal();
+	}
+
+	std::shared_ptr<Board> boardOf(const std::shared_ptr<IPlayer>& player)
+	{
+		return player ? std::dynamic_pointer_cast<Board>(player->getBoard()) : nullptr;
+	}
+}
+
+namespace Serialization
+{
+	BoardBlob encodeBoard(const Board& board)
+	{
+		BoardBlob blob{};
+		const auto& ships = board.getShips();
+		const int count = std::min(static_cast<int>(ships.size()), MAX_PLANES);
+
+		blob[0] = VERSION;
+		blob[1] = static_cast<std::uint8_t>(count);
+		for (int i = 0; i < count; ++i) {
+			const Position head = ships[i].getHead();
+			const auto* placement = PlacementTable::find(head.m_x, head.m_y, ships[i].getOrientation());
+			blob[PLANES_OFFSET + i] = static_cast<std::uint8_t>(placement - PlacementTable::PLACEMENTS.data());
+		}
+		writeShotMask(board.getShotMask(), blob.data() + SHOTS_OFFSET);
+
+		return blob;
+	}
+
+	bool decodeBoard(const BoardBlob& blob, Board& board)
+	{
+		if (!isValid(blob))
+			return false;
+
+		load(blob, board);
+		return true;
+	}
+
+	bool encodeGame(const Game& game, GameBlob& blob)
+	{
+		auto board1 = boardOf(game.getPlayer1());
+		auto board2 = boardOf(game.getPlayer2());
+		if (!board1 || !board2)
+			return false;
+
+		blob[0] = VERSION;
+		blob[1] = static_cast<std::uint8_t>(game.getCurrentPlayerIndex());
+		blob[2] = static_cast<std::uint8_t>(game.getState());
+		blob[3] = static_cast<std::uint8_t>(game.getMaxShips());
+
+		const BoardBlob first = encodeBoard(*board1);
+		const BoardBlob second = encodeBoard(*board2);
+		std::copy(first.begin(), first.end(), blob.begin() + 4);
+		std::copy(second.begin(), second.end(), blob.begin() + 4 + BOARD_BLOB_SIZE);
+
+		return true;
+	}
+
+	bool decodeGame(const GameBlob& blob, Game& game)
+	{
+		auto board1 = boardOf(game.getPlayer1());
+		auto board2 = boardOf(game.getPlayer2());
+		if (!board1 || !board2)
+			return false;
+		if (blob[0] != VERSION || blob[1] > 1 || blob[2] > static_cast<std::uint8_t>(GameState::GameOver))
+			return false;
+
+		BoardBlob first, second;
+		std::copy(blob.begin() + 4, blob.begin() + 4 + BOARD_BLOB_SIZE, first.begin());
+		std::copy(blob.begin() + 4 + BOARD_BLOB_SIZE, blob.end(), second.begin());
+		if (!isValid(first) || !isValid(second))
+			return false;
+
+		const int maxShips = blob[3];
+		if (maxShips == 0 || maxShips > MAX_PLANES || maxShips < first[1] || maxShips < second[1])
+			return false;
+
+		load(first, *board1);
+		load(second, *board2);
+
+		game.restore(blob[1], static_cast<GameState>(blob[2]), maxShips);
+		return true;
+	}
+}
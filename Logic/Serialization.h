@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Board.h"
+#include "Game.h"
+
+// Versioned fixed-size binary encodings of a classic Board and of a two-player Game.
+//
+// Board (32 bytes):
+//   [0]       format version
+//   [1]       plane count (at most MAX_PLANES)
+//   [2..11]   PlacementTable id of every plane, in placement order
+//   [12..24]  shot mask, one bit per cell (y * 10 + x), least significant bit first
+//   [25..31]  reserved, zero
+// A cell's hit or miss state follows from the shot mask and the plane layout.
+//
+// Game (68 bytes): version, current player index, GameState, max planes, then both boards.
+// Decoding checks the whole blob first and leaves the board or game untouched when it is rejected.
+namespace Serialization
+{
+	inline constexpr std::uint8_t VERSION = 1;
+	inline constexpr int MAX_PLANES = 10;
+	inline constexpr int BOARD_BLOB_SIZE = 32;
+	inline constexpr int GAME_BLOB_SIZE = 4 + 2 * BOARD_BLOB_SIZE;
+
+	using BoardBlob = std::array<std::uint8_t, BOARD_BLOB_SIZE>;
+	using GameBlob = std::array<std::uint8_t, GAME_BLOB_SIZE>;
+
+	BoardBlob encodeBoard(const Board& board);
+	bool decodeBoard(const BoardBlob& blob, Board& board);
+
+	// Both players of the game must use the classic Board; returns false otherwise.
+	bool encodeGame(const Game& game, GameBlob& blob);
+	bool decodeGame(const GameBlob& blob, Game& game);
+}
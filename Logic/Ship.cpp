@@ -1,58 +1,65 @@
 #include "Ship.h"
+#include <type_traits>
 
-Ship::Ship(const Position& start, Orientation o) {
-    std::vector<Position> baseOffsets = {
-        {0, 0},                         
-        {-2, 1}, {-1, 1}, {0, 1}, {1, 1}, {2, 1}, 
-        {0, 2},                        
-        {-1, 3}, {0, 3}, {1, 3}         
-    };
-
-    for (size_t i = 0; i < baseOffsets.size(); ++i) {
-        Position rotated = rotate(baseOffsets[i], o);
-        Position finalPos(start.m_x + rotated.m_x, start.m_y + rotated.m_y);
-        m_parts.emplace_back(finalPos, i == 0); 
-    }
-}
+static_assert(std::is_trivially_copyable<Ship>::value, "Ship copies must stay a plain memcpy");
 
-Position Ship::rotate(const Position& position, Orientation orientation) {
-    switch (orientation) {
-    case Orientation::Up:    return position;
-    case Orientation::Down:  return { position.m_x, -position.m_y };
-    case Orientation::Left:  return { position.m_y, -position.m_x };
-    case Orientation::Right: return { -position.m_y, position.m_x };
-    }
-    return position;
+Ship::Ship(const Position& start, Orientation o)
+    : m_hitMask(0), m_headIndex(0), m_orientation(o) {
+    const auto& offsets = PlacementTable::OFFSETS[static_cast<int>(o)];
+
+    for (int i = 0; i < PART_COUNT; ++i)
+        m_positions[i] = Position(start.m_x + offsets[i].x, start.m_y + offsets[i].y);
 }
 
 bool Ship::contains(const Position& position) const {
-    for (const auto& part : m_parts)
-        if (part.getPosition().m_x == position.m_x && part.getPosition().m_y == position.m_y)
+    for (const auto& part : m_positions)
+        if (part.m_x == position.m_x && part.m_y == position.m_y)
             return true;
     return false;
 }
 
 void Ship::hit(const Position& position) {
-    for (auto& part : m_parts) {
-        if (part.getPosition().m_x == position.m_x && part.getPosition().m_y == position.m_y) {
-            part.markHit();
-
-            if (part.isHeadPart()) {
-                for (auto& all : m_parts)
-                    all.markHit();
-                return;
-            }
+    for (int i = 0; i < PART_COUNT; ++i) {
+        if (m_positions[i].m_x == position.m_x && m_positions[i].m_y == position.m_y) {
+            hitPart(i);
+            return;
         }
     }
 }
 
+void Ship::hitPart(int index) {
+    if (index == m_headIndex)
+        m_hitMask = ALL_PARTS;
+    else
+        m_hitMask |= static_cast<std::uint16_t>(1u << index);
+}
+
+void Ship::restoreHitMask(std::uint16_t hitMask) {
+    m_hitMask = hitMask;
+}
+
 bool Ship::isSunk() const {
-    for (const auto& part : m_parts)
-        if (!part.isHit())
-            return false;
-    return true;
+    return m_hitMask == ALL_PARTS;
 }
 
-const std::vector<ShipPart>& Ship::getParts() const {
-	return m_parts;
-}
\ No newline at end of file
+std::array<ShipPart, Ship::PART_COUNT> Ship::getParts() const {
+    std::array<ShipPart, PART_COUNT> parts;
+    for (int i = 0; i < PART_COUNT; ++i) {
+        parts[i] = ShipPart(m_positions[i], i == m_headIndex);
+        if (m_hitMask & (1u << i))
+            parts[i].markHit();
+    }
+    return parts;
+}
+
+Position Ship::getHead() const {
+    return m_positions[m_headIndex];
+}
+
+Orientation Ship::getOrientation() const {
+    return m_orientation;
+}
+
+std::uint16_t Ship::getHitMask() const {
+    return m_hitMask;
+}
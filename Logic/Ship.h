@@ -1,20 +1,33 @@
 #pragma once
-#include <vector>
+#include <array>
+#include <cstdint>
 #include "ShipPart.h"
 #include "Position.h"
 #include "Orientation.h"
+#include "PlacementTable.h"
 
 class Ship {
+public:
+    static constexpr int PART_COUNT = PlacementTable::PART_COUNT;
+    static constexpr std::uint16_t ALL_PARTS = (1u << PART_COUNT) - 1;
+
 private:
-    std::vector<ShipPart> m_parts;
-    static Position rotate(const Position& position, Orientation orientation);
+    std::array<Position, PART_COUNT> m_positions;
+    std::uint16_t m_hitMask;
+    std::uint8_t m_headIndex;
+    Orientation m_orientation;
 
 public:
     Ship(const Position& start, Orientation orientation);
 
     bool contains(const Position& position) const;
     void hit(const Position& position);
+    void hitPart(int index);
+    void restoreHitMask(std::uint16_t hitMask);
     bool isSunk() const;
 
-    const std::vector<ShipPart>& getParts() const;
+    std::array<ShipPart, PART_COUNT> getParts() const;
+    Position getHead() const;
+    Orientation getOrientation() const;
+    std::uint16_t getHitMask() const;
 };
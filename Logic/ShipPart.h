@@ -8,7 +8,7 @@ private:
     bool m_isHead;
 
 public:
-    ShipPart(Position p, bool head = false);
+    ShipPart(Position p = Position(), bool head = false);
 
 
 	void markHit();
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Outcome of IBoard::receiveShots. Bit i of hits/misses/headKills refers to the i-th position
+// of the batch; invalid or repeated shots set no bit. Bit p of destroyedPlanes is set when
+// getShips()[p] went down during the batch.
+struct ShotBatchResult {
+    static constexpr std::size_t MAX_SHOTS = 64;
+    // only planes below this index have a destroyedPlanes bit; the rest still go down, which
+    // getShips() and allShipsSunk() report
+    static constexpr int MAX_PLANES = 64;
+
+    std::uint64_t hits{ 0 };
+    std::uint64_t misses{ 0 };
+    std::uint64_t headKills{ 0 };
+    std::uint64_t destroyedPlanes{ 0 };
+    // positions resolved; batches longer than MAX_SHOTS are cut short
+    int resolved{ 0 };
+};
@@ -0,0 +1,190 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "Board.h"
+#include "DynamicBoard.h"
+#include "GameCore.h"
+#include "RandomStrategies.h"
+
+namespace {
+    template <typename BoardT>
+    GameOutcome playOn(GameCore<BoardT>& core, int boardSize, SplitMix64& rng,
+        IPlacementStrategy& firstPlacement, IShootingStrategy& firstShooter,
+        IPlacementStrategy& secondPlacement, IShootingStrategy& secondShooter)
+    {
+        GameOutcome outcome;
+        core.start();
+
+        // same flow as the UI: player 1 places, turn passes, player 2 places, turn passes back
+        auto tryPlace = [&core](const Ship& plane) { return core.placeShip(plane); };
+        if (!firstPlacement.placeShips(boardSize, core.getMaxShips(), tryPlace, rng))
+            return outcome;
+        core.switchTurn();
+        if (!secondPlacement.placeShips(boardSize, core.getMaxShips(), tryPlace, rng))
+            return outcome;
+        if (!core.switchTurn())
+            return outcome;
+
+        IShootingStrategy* shooters[2] = { &firstShooter, &secondShooter };
+        int shotsBy[2] = { 0, 0 };
+        firstShooter.reset(boardSize);
+        secondShooter.reset(boardSize);
+
+        const int maxShots = 2 * boardSize * boardSize;
+        while (outcome.shots < maxShots) {
+            const int turn = core.getTurn();
+            Position target = shooters[turn]->nextShot(rng);
+            if (target.m_x < 0)
+                break;
+
+            auto result = core.shoot(target);
+            shooters[turn]->onShotResult(Cell{ target, result.hit ? CellState::Hit : CellState::Miss, result.headHit });
+            ++shotsBy[turn];
+            ++outcome.shots;
+
+            if (result.gameOver) {
+                outcome.completed = true;
+                outcome.winner = turn;
+                outcome.winnerShots = shotsBy[turn];
+                break;
+            }
+        }
+        return outcome;
+    }
+}
+
+void SimulationResult::add(const GameOutcome& outcome)
+{
+    ++games;
+    shots += outcome.shots;
+    if (!outcome.completed)
+        return;
+
+    ++completed;
+    if (outcome.winner == 0)
+        ++player1Wins;
+    if (static_cast<int>(shotsToWin.size()) <= outcome.winnerShots)
+        shotsToWin.resize(outcome.winnerShots + 1, 0);
+    ++shotsToWin[outcome.winnerShots];
+}
+
+void SimulationResult::merge(const SimulationResult& other)
+{
+    games += other.games;
+    completed += other.completed;
+    player1Wins += other.player1Wins;
+    shots += other.shots;
+    if (shotsToWin.size() < other.shotsToWin.size())
+        shotsToWin.resize(other.shotsToWin.size(), 0);
+    for (std::size_t n = 0; n < other.shotsToWin.size(); ++n)
+        shotsToWin[n] += other.shotsToWin[n];
+}
+
+double SimulationResult::gamesPerSecond() const
+{
+    return seconds > 0.0 ? games / seconds : 0.0;
+}
+
+double SimulationResult::shotsPerSecond() const
+{
+    return seconds > 0.0 ? static_cast<double>(shots) / seconds : 0.0;
+}
+
+double SimulationResult::meanShotsToWin() const
+{
+    if (completed == 0)
+        return 0.0;
+
+    std::uint64_t total = 0;
+    for (std::size_t n = 0; n < shotsToWin.size(); ++n)
+        total += n * shotsToWin[n];
+    return static_cast<double>(total) / completed;
+}
+
+int SimulationResult::shotsToWinPercentile(double p) const
+{
+    const double target = p * completed;
+    std::uint64_t seen = 0;
+    for (std::size_t n = 0; n < shotsToWin.size(); ++n) {
+        seen += shotsToWin[n];
+        if (seen > 0 && seen >= target)
+            return static_cast<int>(n);
+    }
+    return 0;
+}
+
+SimulationRunner::SimulationRunner(SimulationConfig config)
+    : m_config(std::move(config))
+{
+    if (!m_config.makePlacement)
+        m_config.makePlacement = [] { return std::make_unique<RandomPlacement>(); };
+    if (!m_config.makeShooter)
+        m_config.makeShooter = [] { return std::make_unique<RandomShooter>(); };
+}
+
+SimulationResult SimulationRunner::run() const
+{
+    int threads = m_config.threads > 0 ? m_config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, (m_config.games + CHUNK - 1) / CHUNK));
+
+    std::atomic<int> nextGame{ 0 };
+    std::vector<SimulationResult> partial(threads);
+
+    auto worker = [&](SimulationResult& result) {
+        auto placement = m_config.makePlacement();
+        auto first = m_config.makeShooter();
+        auto second = m_config.makeShooter();
+
+        for (;;) {
+            int begin = nextGame.fetch_add(CHUNK, std::memory_order_relaxed);
+            if (begin >= m_config.games)
+                break;
+            int end = std::min(begin + CHUNK, m_config.games);
+            for (int game = begin; game < end; ++game)
+                result.add(playGame(game, *placement, *first, *second));
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(worker, std::ref(partial[t]));
+    worker(partial[0]);
+    for (auto& thread : pool)
+        thread.join();
+
+    SimulationResult result;
+    for (const auto& part : partial)
+        result.merge(part);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+GameOutcome SimulationRunner::playGame(int gameIndex, IPlacementStrategy& placement,
+    IShootingStrategy& firstShooter, IShootingStrategy& secondShooter) const
+{
+    SplitMix64 rng = SplitMix64::forStream(m_config.seed, static_cast<std::uint64_t>(gameIndex));
+    return playMatch(m_config.boardSize, m_config.maxShips, rng, placement, firstShooter, placement, secondShooter);
+}
+
+GameOutcome SimulationRunner::playMatch(int boardSize, int maxShips, SplitMix64& rng,
+    IPlacementStrategy& firstPlacement, IShootingStrategy& firstShooter,
+    IPlacementStrategy& secondPlacement, IShootingStrategy& secondShooter)
+{
+    // same boards GameFactory would pick, held by value
+    if (boardSize == Board::SIZE) {
+        GameCore<Board> core(maxShips);
+        return playOn(core, boardSize, rng, firstPlacement, firstShooter, secondPlacement, secondShooter);
+    }
+
+    GameCore<DynamicBoard> core(maxShips, boardSize);
+    return playOn(core, boardSize, rng, firstPlacement, firstShooter, secondPlacement, secondShooter);
+}
+
+const SimulationConfig& SimulationRunner::getConfig() const
+{
+    return m_config;
+}
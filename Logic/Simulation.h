@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "GameFactory.h"
+#include "IPlacementStrategy.h"
+#include "IShootingStrategy.h"
+
+struct SimulationConfig {
+    int games{ 1000 };
+    int threads{ 0 };                  // 0 = one per hardware thread
+    std::uint64_t seed{ 1 };
+    int boardSize{ GameFactory::CLASSIC_BOARD_SIZE };
+    int maxShips{ GameFactory::CLASSIC_MAX_SHIPS };
+    // Each worker thread builds its own strategies; both players use the same kind.
+    std::function<std::unique_ptr<IPlacementStrategy>()> makePlacement;
+    std::function<std::unique_ptr<IShootingStrategy>()> makeShooter;
+};
+
+struct GameOutcome {
+    bool completed{ false };
+    int winner{ -1 };                  // 0 = player 1, 1 = player 2
+    int shots{ 0 };                    // both players
+    int winnerShots{ 0 };
+};
+
+struct SimulationResult {
+    int games{ 0 };
+    int completed{ 0 };
+    int player1Wins{ 0 };
+    std::uint64_t shots{ 0 };
+    double seconds{ 0.0 };
+    // shotsToWin[n] = number of games the winner needed n shots for
+    std::vector<std::uint64_t> shotsToWin;
+
+    void add(const GameOutcome& outcome);
+    void merge(const SimulationResult& other);
+    double gamesPerSecond() const;
+    double shotsPerSecond() const;
+    double meanShotsToWin() const;
+    // Smallest n such that at least fraction p of the completed games were won in n shots or fewer.
+    int shotsToWinPercentile(double p) const;
+};
+
+// Plays full games on GameCore boards on every core. Game i is seeded from (seed, i) only,
+// so the same config gives the same histogram whatever the thread count.
+class SimulationRunner {
+public:
+    // Games are handed out to threads in chunks of this size.
+    static constexpr int CHUNK = 16;
+
+    explicit SimulationRunner(SimulationConfig config);
+
+    SimulationResult run() const;
+    GameOutcome playGame(int gameIndex, IPlacementStrategy& placement,
+        IShootingStrategy& firstShooter, IShootingStrategy& secondShooter) const;
+
+    // One full game between two bots; player 1 places and shoots first.
+    static GameOutcome playMatch(int boardSize, int maxShips, SplitMix64& rng,
+        IPlacementStrategy& firstPlacement, IShootingStrategy& firstShooter,
+        IPlacementStrategy& secondPlacement, IShootingStrategy& secondShooter);
+
+    const SimulationConfig& getConfig() const;
+
+private:
+    SimulationConfig m_config;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+// Small, fast 64-bit generator. Each simulated game seeds its own instance from (seed, game index),
+// so results do not depend on how games are spread over threads.
+struct SplitMix64 {
+    std::uint64_t state{ 0 };
+
+    static constexpr std::uint64_t GAMMA = 0x9E3779B97F4A7C15ull;
+
+    explicit SplitMix64(std::uint64_t seed = 0) : state(seed) {}
+
+    // The value next() returns from state x; also usable as a compile-time hash (Zobrist keys).
+    static constexpr std::uint64_t mix(std::uint64_t x)
+    {
+        std::uint64_t z = x + GAMMA;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t next()
+    {
+        const std::uint64_t z = mix(state);
+        state += GAMMA;
+        return z;
+    }
+
+    // Uniform value in [0, bound), bound > 0.
+    int nextInt(int bound)
+    {
+        return static_cast<int>((next() >> 32) * static_cast<std::uint64_t>(bound) >> 32);
+    }
+
+    static SplitMix64 forStream(std::uint64_t seed, std::uint64_t stream)
+    {
+        SplitMix64 mixer(seed ^ (stream * 0xD1B54A32D192ED03ull));
+        return SplitMix64(mixer.next());
+    }
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// N must be a power of two. Each side caches the other side's index, so the shared
+// atomics are only re-read when the queue looks full (producer) or empty (consumer).
+template <typename T, std::size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    static constexpr std::size_t CAPACITY = N;
+
+    // Producer side.
+    bool tryPush(const T& value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == N) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == N)
+                return false;
+        }
+        m_items[tail & (N - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side: a push right after this returned false is guaranteed to succeed.
+    bool full()
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache < N)
+            return false;
+        m_headCache = m_head.load(std::memory_order_acquire);
+        return tail - m_headCache == N;
+    }
+
+    // Consumer side.
+    bool tryPop(T& value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+                return false;
+        }
+        value = m_items[head & (N - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: pops up to maxItems and hands each one to fn.
+    template <typename Fn>
+    std::size_t drain(Fn&& fn, std::size_t maxItems = N)
+    {
+        std::size_t count = 0;
+        T value;
+        while (count < maxItems && tryPop(value)) {
+            fn(value);
+            ++count;
+        }
+        return count;
+    }
+
+    // Either side; only a snapshot while the other side is running.
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> m_head{ 0 };
+    std::size_t m_tailCache{ 0 };                      // consumer's copy of m_tail
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 };
+    std::size_t m_headCache{ 0 };                      // producer's copy of m_head
+    alignas(64) std::array<T, N> m_items{};
+};
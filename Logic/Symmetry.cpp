@@ -0,0 +1,105 @@
+#include "Symmetry.h"
+#include <algorithm>
+
+namespace
+{
+	bool less(const BitMask128& a, const BitMask128& b)
+	{
+		return a.words[1] != b.words[1] ? a.words[1] < b.words[1] : a.words[0] < b.words[0];
+	}
+
+	bool less(const LayoutObservation& a, const LayoutObservation& b)
+	{
+		if (a.hits != b.hits)
+			return less(a.hits, b.hits);
+		if (a.misses != b.misses)
+			return less(a.misses, b.misses);
+		return less(a.heads, b.heads);
+	}
+}
+
+BitMask128 Symmetry::apply(const BitMask128& mask, int symmetry)
+{
+	BitMask128 image;
+	mask.forEachBit([&](int cell) { image.set(mapCell(cell, symmetry)); });
+	return image;
+}
+
+LayoutObservation Symmetry::apply(const LayoutObservation& observation, int symmetry)
+{
+	LayoutObservation image;
+	image.hits = apply(observation.hits, symmetry);
+	image.misses = apply(observation.misses, symmetry);
+	image.heads = apply(observation.heads, symmetry);
+	return image;
+}
+
+LayoutDensity Symmetry::apply(const LayoutDensity& density, int symmetry)
+{
+	LayoutDensity image;
+	image.layouts = density.layouts;
+	for (int cell = 0; cell < PlacementTable::CELL_COUNT; ++cell) {
+		const int target = mapCell(cell, symmetry);
+		image.occupied[target] = density.occupied[cell];
+		image.heads[target] = density.heads[cell];
+	}
+	return image;
+}
+
+BitMask128 Symmetry::canonical(const BitMask128& mask)
+{
+	BitMask128 best = mask;
+	for (int s = 1; s < COUNT; ++s) {
+		BitMask128 image = apply(mask, s);
+		if (less(image, best))
+			best = image;
+	}
+	return best;
+}
+
+int Symmetry::canonicalize(const LayoutObservation& observation, LayoutObservation& canonical)
+{
+	int best = IDENTITY;
+	canonical = observation;
+	for (int s = 1; s < COUNT; ++s) {
+		LayoutObservation image = apply(observation, s);
+		if (less(image, canonical)) {
+			canonical = image;
+			best = s;
+		}
+	}
+	return best;
+}
+
+std::uint8_t Symmetry::layoutImages(const std::uint8_t* ids, int count)
+{
+	// most layouts already lose on their lowest id, without sorting anything
+	if (count > 0) {
+		const std::uint8_t lowest = *std::min_element(ids, ids + count);
+		for (int s = 1; s < COUNT; ++s) {
+			for (int i = 0; i < count; ++i) {
+				if (PLACEMENTS[s][ids[i]] < lowest)
+					return 0;
+			}
+		}
+	}
+
+	std::uint8_t images[COUNT][LayoutEnumerator::MAX_PLANES]{};
+	for (int s = 0; s < COUNT; ++s) {
+		for (int i = 0; i < count; ++i)
+			images[s][i] = PLACEMENTS[s][ids[i]];
+		std::sort(images[s], images[s] + count);
+	}
+
+	std::uint8_t distinct = 0;
+	for (int s = 0; s < COUNT; ++s) {
+		if (std::lexicographical_compare(images[s], images[s] + count, images[IDENTITY], images[IDENTITY] + count))
+			return 0;
+		bool repeated = false;
+		for (int t = 0; t < s && !repeated; ++t)
+			repeated = std::equal(images[s], images[s] + count, images[t]);
+		if (!repeated)
+			distinct |= static_cast<std::uint8_t>(1u << s);
+	}
+	return distinct;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "BitMask.h"
+#include "LayoutEnumerator.h"
+#include "PlacementTable.h"
+
+// The 8 rotations and reflections of the classic 10x10 board. The plane is mirror symmetric and
+// the four orientations are its rotations, so every symmetry maps placements onto placements and
+// layouts onto layouts; positions that are images of each other have mirrored heatmaps.
+//
+// Symmetry s transposes the board if bit 2 is set, then mirrors x (bit 0) and y (bit 1).
+namespace Symmetry
+{
+	inline constexpr int COUNT = 8;
+	inline constexpr int IDENTITY = 0;
+
+	constexpr int mapCell(int cell, int symmetry)
+	{
+		constexpr int last = PlacementTable::BOARD_SIZE - 1;
+		int x = cell % PlacementTable::BOARD_SIZE;
+		int y = cell / PlacementTable::BOARD_SIZE;
+		if (symmetry & 4) {
+			int swap = x;
+			x = y;
+			y = swap;
+		}
+		if (symmetry & 1)
+			x = last - x;
+		if (symmetry & 2)
+			y = last - y;
+		return y * PlacementTable::BOARD_SIZE + x;
+	}
+
+	constexpr std::array<int, COUNT> buildInverse()
+	{
+		std::array<int, COUNT> inverse{};
+		for (int s = 0; s < COUNT; ++s) {
+			for (int t = 0; t < COUNT; ++t) {
+				bool undoes = true;
+				for (int cell = 0; cell < PlacementTable::CELL_COUNT && undoes; ++cell)
+					undoes = mapCell(mapCell(cell, s), t) == cell;
+				if (undoes)
+					inverse[s] = t;
+			}
+		}
+		return inverse;
+	}
+
+	// The symmetry that undoes each one.
+	inline constexpr auto INVERSE = buildInverse();
+
+	constexpr std::array<std::array<std::uint8_t, PlacementTable::COUNT>, COUNT> buildPlacementMap()
+	{
+		std::array<std::array<std::uint8_t, PlacementTable::COUNT>, COUNT> map{};
+		for (int s = 0; s < COUNT; ++s) {
+			for (int id = 0; id < PlacementTable::COUNT; ++id) {
+				const auto& placement = PlacementTable::PLACEMENTS[id];
+				BitMask128 mask;
+				for (int cell : placement.cells)
+					mask.set(mapCell(cell, s));
+				const int head = mapCell(placement.head, s);
+				for (int o = 0; o < PlacementTable::ORIENTATION_COUNT; ++o) {
+					const int image = PlacementTable::INDEX[head * PlacementTable::ORIENTATION_COUNT + o];
+					if (image >= 0 && PlacementTable::PLACEMENTS[image].mask == mask)
+						map[s][id] = static_cast<std::uint8_t>(image);
+				}
+			}
+		}
+		return map;
+	}
+
+	// PlacementTable id of each placement's image, indexed by [symmetry][id].
+	inline constexpr auto PLACEMENTS = buildPlacementMap();
+
+	BitMask128 apply(const BitMask128& mask, int symmetry);
+	LayoutObservation apply(const LayoutObservation& observation, int symmetry);
+	// Tallies of the mirrored position: what the original had on a cell lands on its image.
+	LayoutDensity apply(const LayoutDensity& density, int symmetry);
+
+	// Smallest image of the mask (high word first).
+	BitMask128 canonical(const BitMask128& mask);
+	// Writes the smallest image of the observation and returns the symmetry that produced it.
+	int canonicalize(const LayoutObservation& observation, LayoutObservation& canonical);
+
+	// For a layout given as placement ids: 0 unless its sorted ids are the smallest of all its
+	// images, else bit s set for every symmetry s whose image differs from those of the
+	// symmetries below it. Each layout is then counted once per set bit, and an orbit is listed
+	// exactly once however symmetric its layouts are.
+	std::uint8_t layoutImages(const std::uint8_t* ids, int count);
+}
@@ -0,0 +1,128 @@
+#include "Tournament.h"
+#include <chrono>
+#include <utility>
+#include "RandomStrategies.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+
+namespace {
+    struct alignas(64) WorkerResult {
+        std::vector<std::uint64_t> wins;
+        std::vector<std::uint64_t> games;
+        std::vector<std::uint64_t> shots;
+        std::uint64_t unfinished{ 0 };
+    };
+
+    struct WorkerBots {
+        std::vector<std::unique_ptr<IPlacementStrategy>> placements;
+        std::vector<std::unique_ptr<IShootingStrategy>> shooters;
+    };
+}
+
+std::uint64_t TournamentResult::winsAgainst(int winner, int loser) const
+{
+    return wins[winner * standings.size() + loser];
+}
+
+double TournamentResult::matchesPerSecond() const
+{
+    return seconds > 0.0 ? matches / seconds : 0.0;
+}
+
+Tournament::Tournament(TournamentConfig config)
+    : m_config(config)
+{
+}
+
+void Tournament::addEntry(TournamentEntry entry)
+{
+    if (!entry.makePlacement)
+        entry.makePlacement = [] { return std::make_unique<RandomPlacement>(); };
+    if (!entry.makeShooter)
+        entry.makeShooter = [] { return std::make_unique<RandomShooter>(); };
+    m_entries.push_back(std::move(entry));
+}
+
+int Tournament::getEntryCount() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+TournamentResult Tournament::run() const
+{
+    const int entries = getEntryCount();
+    std::vector<std::pair<int, int>> pairings;
+    for (int i = 0; i < entries; ++i)
+        for (int j = i + 1; j < entries; ++j)
+            pairings.emplace_back(i, j);
+
+    const auto matchCount = static_cast<std::uint32_t>(pairings.size() * m_config.gamesPerPairing);
+
+    WorkStealingPool pool(m_config.threads);
+    std::vector<WorkerResult> results(pool.getThreadCount());
+    std::vector<WorkerBots> bots(pool.getThreadCount());
+    for (int w = 0; w < pool.getThreadCount(); ++w) {
+        results[w].wins.assign(entries * entries, 0);
+        results[w].games.assign(entries, 0);
+        results[w].shots.assign(entries, 0);
+        bots[w].placements.resize(entries);
+        bots[w].shooters.resize(entries);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    pool.run(matchCount, [&](int worker, std::uint32_t match) {
+        auto [a, b] = pairings[match / m_config.gamesPerPairing];
+        if (match % m_config.gamesPerPairing % 2)
+            std::swap(a, b);
+
+        // strategies are built lazily, once per worker and entry
+        WorkerBots& own = bots[worker];
+        for (int entry : { a, b }) {
+            if (!own.placements[entry]) {
+                own.placements[entry] = m_entries[entry].makePlacement();
+                own.shooters[entry] = m_entries[entry].makeShooter();
+            }
+        }
+
+        SplitMix64 rng = SplitMix64::forStream(m_config.seed, match);
+        GameOutcome outcome = SimulationRunner::playMatch(m_config.boardSize, m_config.maxShips, rng,
+            *own.placements[a], *own.shooters[a], *own.placements[b], *own.shooters[b]);
+
+        WorkerResult& result = results[worker];
+        ++result.games[a];
+        ++result.games[b];
+        if (!outcome.completed) {
+            ++result.unfinished;
+            return;
+        }
+        int winner = outcome.winner == 0 ? a : b;
+        int loser = outcome.winner == 0 ? b : a;
+        ++result.wins[winner * entries + loser];
+        result.shots[winner] += outcome.winnerShots;
+    });
+
+    TournamentResult total;
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    total.matches = matchCount;
+    total.steals = pool.getStealCount();
+    total.wins.assign(entries * entries, 0);
+    total.standings.resize(entries);
+    for (int i = 0; i < entries; ++i)
+        total.standings[i].name = m_entries[i].name;
+
+    for (const auto& result : results) {
+        total.unfinished += result.unfinished;
+        for (int i = 0; i < entries * entries; ++i)
+            total.wins[i] += result.wins[i];
+        for (int i = 0; i < entries; ++i) {
+            total.standings[i].games += result.games[i];
+            total.standings[i].shots += result.shots[i];
+        }
+    }
+    for (int i = 0; i < entries; ++i)
+        for (int j = 0; j < entries; ++j)
+            total.standings[i].wins += total.wins[i * entries + j];
+
+    return total;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameFactory.h"
+#include "IPlacementStrategy.h"
+#include "IShootingStrategy.h"
+
+struct TournamentEntry {
+    std::string name;
+    std::function<std::unique_ptr<IPlacementStrategy>()> makePlacement;
+    std::function<std::unique_ptr<IShootingStrategy>()> makeShooter;
+};
+
+struct TournamentConfig {
+    int gamesPerPairing{ 1000 };        // each pairing swaps who moves first every game
+    int threads{ 0 };                   // 0 = one per hardware thread
+    std::uint64_t seed{ 1 };
+    int boardSize{ GameFactory::CLASSIC_BOARD_SIZE };
+    int maxShips{ GameFactory::CLASSIC_MAX_SHIPS };
+};
+
+struct TournamentStanding {
+    std::string name;
+    std::uint64_t games{ 0 };
+    std::uint64_t wins{ 0 };
+    std::uint64_t shots{ 0 };           // shots fired in games this entry won
+};
+
+struct TournamentResult {
+    std::vector<TournamentStanding> standings;  // same order as the entries
+    // wins[i * entries + j] = games entry i won against entry j
+    std::vector<std::uint64_t> wins;
+    std::uint64_t matches{ 0 };
+    std::uint64_t unfinished{ 0 };
+    std::uint64_t steals{ 0 };
+    double seconds{ 0.0 };
+
+    std::uint64_t winsAgainst(int winner, int loser) const;
+    double matchesPerSecond() const;
+};
+
+// Round-robin between every pair of entries, every match a fresh GameCore.
+// Matches run on a WorkStealingPool; each worker fills its own accumulator and the accumulators
+// are added up once all matches are done.
+class Tournament {
+public:
+    explicit Tournament(TournamentConfig config);
+
+    void addEntry(TournamentEntry entry);
+    int getEntryCount() const;
+    TournamentResult run() const;
+
+private:
+    TournamentConfig m_config;
+    std::vector<TournamentEntry> m_entries;
+};
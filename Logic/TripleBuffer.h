@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Latest-value handoff between one writer and one reader thread without locks.
+// The writer fills back() and calls publish(); the reader calls update() and reads front(),
+// which stays untouched by the writer until the reader calls update() again.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side.
+    T& back() { return m_buffers[m_back]; }
+
+    void publish()
+    {
+        m_back = m_middle.exchange(static_cast<std::uint8_t>(m_back | DIRTY), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader side: true when a newer value was published since the last call.
+    bool update()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & DIRTY))
+            return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    const T& front() const { return m_buffers[m_front]; }
+
+private:
+    static constexpr std::uint8_t INDEX = 3;
+    static constexpr std::uint8_t DIRTY = 4;
+
+    T m_buffers[3]{};
+    std::uint8_t m_back{ 0 };
+    std::atomic<std::uint8_t> m_middle{ 1 };
+    std::uint8_t m_front{ 2 };
+};
@@ -0,0 +1,114 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : m_threads(threads > 0 ? threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))),
+    m_slots(std::make_unique<Slot[]>(m_threads))
+{
+}
+
+int WorkStealingPool::getThreadCount() const
+{
+    return m_threads;
+}
+
+std::uint64_t WorkStealingPool::getStealCount() const
+{
+    std::uint64_t total = 0;
+    for (int i = 0; i < m_threads; ++i)
+        total += m_slots[i].steals;
+    return total;
+}
+
+void WorkStealingPool::run(std::uint32_t itemCount, const Task& task)
+{
+    // static split to start with, stealing evens it out
+    for (int i = 0; i < m_threads; ++i) {
+        auto begin = static_cast<std::uint32_t>(static_cast<std::uint64_t>(itemCount) * i / m_threads);
+        auto end = static_cast<std::uint32_t>(static_cast<std::uint64_t>(itemCount) * (i + 1) / m_threads);
+        m_slots[i].range.store(pack(begin, end), std::memory_order_relaxed);
+        m_slots[i].steals = 0;
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < m_threads; ++i)
+        threads.emplace_back([this, i, &task] { work(i, task); });
+    work(0, task);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+std::uint64_t WorkStealingPool::pack(std::uint32_t begin, std::uint32_t end)
+{
+    return static_cast<std::uint64_t>(end) << 32 | begin;
+}
+
+std::uint32_t WorkStealingPool::beginOf(std::uint64_t range)
+{
+    return static_cast<std::uint32_t>(range);
+}
+
+std::uint32_t WorkStealingPool::endOf(std::uint64_t range)
+{
+    return static_cast<std::uint32_t>(range >> 32);
+}
+
+bool WorkStealingPool::popFront(int worker, std::uint32_t& item)
+{
+    auto& range = m_slots[worker].range;
+    std::uint64_t current = range.load(std::memory_order_acquire);
+    while (beginOf(current) < endOf(current)) {
+        if (range.compare_exchange_weak(current, pack(beginOf(current) + 1, endOf(current)),
+            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            item = beginOf(current);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::steal(int thief)
+{
+    for (;;) {
+        int victim = -1;
+        std::uint64_t victimRange = 0;
+        std::uint32_t most = 0;
+        for (int i = 0; i < m_threads; ++i) {
+            if (i == thief)
+                continue;
+            std::uint64_t range = m_slots[i].range.load(std::memory_order_acquire);
+            std::uint32_t left = endOf(range) - beginOf(range);
+            // a single item is left to its owner, it is about to take it anyway
+            if (beginOf(range) + 1 < endOf(range) && left > most) {
+                most = left;
+                victim = i;
+                victimRange = range;
+            }
+        }
+        if (victim < 0)
+            return false;
+
+        // the owner keeps the lower half, including the odd item
+        std::uint32_t begin = beginOf(victimRange);
+        std::uint32_t end = endOf(victimRange);
+        std::uint32_t mid = begin + (end - begin + 1) / 2;
+        if (m_slots[victim].range.compare_exchange_strong(victimRange, pack(begin, mid),
+            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            // nobody steals from an empty range, so a plain store is enough here
+            m_slots[thief].range.store(pack(mid, end), std::memory_order_release);
+            ++m_slots[thief].steals;
+            return true;
+        }
+    }
+}
+
+void WorkStealingPool::work(int worker, const Task& task)
+{
+    do {
+        std::uint32_t item;
+        while (popFront(worker, item))
+            task(worker, item);
+    } while (steal(worker));
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+// Runs fn(worker, item) for every item in [0, itemCount) on a fixed set of threads.
+// Each worker owns a contiguous range packed into one atomic word (begin in the low half,
+// end in the high half). The owner takes items from the front; an idle worker steals the
+// upper half of the fullest range it can find. Both sides only ever CAS the range word,
+// so the per-item path has no locks.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(int worker, std::uint32_t item)>;
+
+    explicit WorkStealingPool(int threads = 0);
+
+    int getThreadCount() const;
+    void run(std::uint32_t itemCount, const Task& task);
+    // Ranges taken from another worker during the last run.
+    std::uint64_t getStealCount() const;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> range{ 0 };
+        std::uint64_t steals{ 0 };
+    };
+
+    static std::uint64_t pack(std::uint32_t begin, std::uint32_t end);
+    static std::uint32_t beginOf(std::uint64_t range);
+    static std::uint32_t endOf(std::uint64_t range);
+
+    bool popFront(int worker, std::uint32_t& item);
+    bool steal(int thief);
+    void work(int worker, const Task& task);
+
+    int m_threads;
+    std::unique_ptr<Slot[]> m_slots;
+};
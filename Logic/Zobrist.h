@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "PlacementTable.h"
+#include "SplitMix64.h"
+
+// Fixed 64-bit Zobrist keys per (feature, cell) of the 10x10 board. The keys are generated
+// at compile time so hashes are stable across runs and processes.
+namespace Zobrist
+{
+	enum Feature {
+		HitCell,
+		MissCell,
+		HeadKill,
+		ShipCell,
+		HeadCell,
+		FEATURE_COUNT
+	};
+
+	constexpr std::array<std::array<std::uint64_t, PlacementTable::CELL_COUNT>, FEATURE_COUNT> buildKeys()
+	{
+		std::array<std::array<std::uint64_t, PlacementTable::CELL_COUNT>, FEATURE_COUNT> keys{};
+		for (int f = 0; f < FEATURE_COUNT; ++f)
+			for (int cell = 0; cell < PlacementTable::CELL_COUNT; ++cell)
+				keys[f][cell] = SplitMix64::mix(static_cast<std::uint64_t>(f * PlacementTable::CELL_COUNT + cell));
+		return keys;
+	}
+
+	inline constexpr auto KEYS = buildKeys();
+
+	constexpr std::uint64_t key(Feature feature, int cell)
+	{
+		return KEYS[feature][cell];
+	}
+}
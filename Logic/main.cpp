@@ -1,76 +1,184 @@
-﻿#include <iostream>
+﻿#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
 #include <memory>
-#include "Game.h"
-#include "Player.h"
-#include "Board.h"
-#include "Orientation.h"
-#include "GameFactory.h"
-
-int main() {
-    std::cout << "========== SIMULARE GAME 2 JUCATORI ==========\n\n";
-
-    GameFactory factory;
-    auto game = factory.create();
-
-    game->startGame();
-
-    // ============================
-    //   PLASARE AVIOANE
-    // ============================
-
-    std::cout << "\n=== Player1 isi plaseaza avioanele ===\n";
-
-    game->placeShip({ 3,3 }, 10, Orientation::Up);
-    game->placeShip({ 8,5 }, 10, Orientation::Right);
-
-    auto board1 = game->getPlayer1()->getBoard();
-    auto board2 = game->getPlayer2()->getBoard();
-    board1->print();
-
-    std::cout << "\n=== Player2 isi plaseaza avioanele ===\n";
-
-    // switch manually since Game expects players to alternate
-    game->switchTurn();
-
-    game->placeShip({ 2,2 }, 10, Orientation::Down);   // avion 1
-    game->placeShip({ 6,7 }, 10, Orientation::Left);   // avion 2
-
-    board2->print();
-
-    // ============================
-    //   SIMULARE TRAGERI
-    // ============================
-
-    std::cout << "\n========== ÎNCEP TRAGERILE ==========\n\n";
-
-    std::cout << "\n Runda 1: P1 trage în head-ul lui P2 la (2,2)\n";
-    game->shoot({ 2, 2 });
-    board2->print();
-
-    std::cout << "\n Runda 2: P2 trage în head-ul lui P1 la (3,3)\n";
-    game->shoot({ 3, 3 });
-
-    std::cout << "\n🎯 Runda 3: P1 trage în head-ul avionului 2 P2 la (6,7)\n";
-    game->shoot({ 6, 7 });
-
-    std::cout << "\n🎯 Runda 4: P2 trage în head-ul avionului 2 P1 la (8,5)\n";
-    game->shoot({ 8, 5 });
-    board1->print();
+#include <string>
+#include <vector>
+#include "DensityShooter.h"
+#include "RandomStrategies.h"
+#include "Simulation.h"
+#include "Tournament.h"
+
+// Headless simulator: plays N full games on every core and reports throughput and shots-to-win.
+//   simulate [--games N] [--threads N] [--seed N] [--size N] [--ships N]
+//            [--shooter random|hunt|density|heads] [--layout-db PATH]
+//   simulate --tournament [--games N per pairing] ...   round-robin between all shooters
+
+static void printUsage()
+{
+    std::cout << "usage: simulate [--tournament] [--games N] [--threads N] [--seed N] [--size N] [--ships N] [--shooter random|hunt|density|heads] [--layout-db PATH]\n";
+}
 
-    // ============================
-    //   FINAL JOC
-    // ============================
+using DensityFactory = std::function<std::unique_ptr<IShootingStrategy>(DensityShooter::Aim)>;
+
+static int runTournament(const SimulationConfig& config, const DensityFactory& makeDensity)
+{
+    TournamentConfig tournamentConfig;
+    tournamentConfig.gamesPerPairing = config.games;
+    tournamentConfig.threads = config.threads;
+    tournamentConfig.seed = config.seed;
+    tournamentConfig.boardSize = config.boardSize;
+    tournamentConfig.maxShips = config.maxShips;
+
+    Tournament tournament(tournamentConfig);
+    tournament.addEntry({ "random", nullptr, [] { return std::make_unique<RandomShooter>(); } });
+    tournament.addEntry({ "hunt", nullptr, [] { return std::make_unique<HuntShooter>(); } });
+    tournament.addEntry({ "density", nullptr, [makeDensity] { return makeDensity(DensityShooter::Aim::Parts); } });
+    tournament.addEntry({ "heads", nullptr, [makeDensity] { return makeDensity(DensityShooter::Aim::Heads); } });
+
+    TournamentResult result = tournament.run();
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "matches:      " << result.matches << " (" << result.unfinished << " not finished)\n"
+        << "time:         " << result.seconds * 1000.0 << " ms\n"
+        << "matches/sec:  " << result.matchesPerSecond() << "\n"
+        << "steals:       " << result.steals << "\n\n";
+
+    for (const auto& standing : result.standings) {
+        double winRate = standing.games ? 100.0 * standing.wins / standing.games : 0.0;
+        double shotsPerWin = standing.wins ? static_cast<double>(standing.shots) / standing.wins : 0.0;
+        std::cout << std::setw(10) << standing.name << "  won " << standing.wins << "/" << standing.games
+            << " (" << winRate << "%), " << shotsPerWin << " shots per win\n";
+    }
+    return 0;
+}
 
-    std::cout << "\n========== VERIFICAM CINE A CASTIGAT ==========\n\n";
+static void printHistogram(const SimulationResult& result)
+{
+    constexpr int BUCKET = 5;
+    constexpr int BAR_WIDTH = 50;
+
+    std::uint64_t peak = 0;
+    std::vector<std::uint64_t> buckets((result.shotsToWin.size() + BUCKET - 1) / BUCKET, 0);
+    for (std::size_t n = 0; n < result.shotsToWin.size(); ++n)
+        buckets[n / BUCKET] += result.shotsToWin[n];
+    for (auto count : buckets)
+        peak = std::max(peak, count);
+
+    for (std::size_t b = 0; b < buckets.size(); ++b) {
+        if (buckets[b] == 0)
+            continue;
+        std::cout << std::setw(4) << b * BUCKET << "-" << std::setw(4) << b * BUCKET + BUCKET - 1
+            << " | " << std::setw(8) << buckets[b] << " "
+            << std::string(static_cast<std::size_t>(buckets[b] * BAR_WIDTH / peak), '#') << "\n";
+    }
+}
 
-    if (board1->allShipsSunk() && board2->allShipsSunk())
-        std::cout << " Remiza (teoretic imposibil dar logic permis)\n";
-    else if (board1->allShipsSunk())
-        std::cout << " Player2 castiga! Player1 nu mai are avioane.\n";
-    else if (board2->allShipsSunk())
-        std::cout << " Player1 castiga! Player2 nu mai are avioane.\n";
-    else
-        std::cout << "Amandoi mai au avioane (jocul nu s-a terminat)\n";
+int main(int argc, char** argv)
+{
+    SimulationConfig config;
+    std::string shooter = "random";
+    std::string layoutDatabase;
+    bool tournament = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "--help")) {
+            printUsage();
+            return 0;
+        }
+        if (!std::strcmp(arg, "--tournament")) {
+            tournament = true;
+            continue;
+        }
+        if (!value) {
+            printUsage();
+            return 1;
+        }
+        if (!std::strcmp(arg, "--games")) config.games = std::atoi(value);
+        else if (!std::strcmp(arg, "--threads")) config.threads = std::atoi(value);
+        else if (!std::strcmp(arg, "--seed")) config.seed = std::strtoull(value, nullptr, 10);
+        else if (!std::strcmp(arg, "--size")) config.boardSize = std::atoi(value);
+        else if (!std::strcmp(arg, "--ships")) config.maxShips = std::atoi(value);
+        else if (!std::strcmp(arg, "--shooter")) shooter = value;
+        else if (!std::strcmp(arg, "--layout-db")) layoutDatabase = value;
+        else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (config.games <= 0 || config.boardSize < GameFactory::MIN_BOARD_SIZE || config.boardSize > GameFactory::MAX_BOARD_SIZE || config.maxShips <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    // every density shooter filters the same mapped copy of the database, and shares the
+    // heatmaps of positions (and their mirrors) another game already counted
+    DensityFactory makeDensity;
+    auto cache = std::make_shared<DensityCache>();
+    if (!layoutDatabase.empty()) {
+        auto database = std::make_shared<LayoutDatabase>();
+        if (!database->open(layoutDatabase) || database->getPlaneCount() != config.maxShips || config.boardSize != GameFactory::CLASSIC_BOARD_SIZE) {
+            std::cerr << "simulate: " << layoutDatabase << " is not a layout database for this board and plane count\n";
+            return 1;
+        }
+        makeDensity = [database, cache](DensityShooter::Aim aim) {
+            auto density = std::make_unique<DensityShooter>(database, aim);
+            density->setCache(cache);
+            return density;
+        };
+    }
+    else {
+        const int planes = config.maxShips;
+        makeDensity = [planes, cache](DensityShooter::Aim aim) {
+            auto density = std::make_unique<DensityShooter>(planes, aim);
+            density->setCache(cache);
+            return density;
+        };
+    }
+
+    if (tournament)
+        return runTournament(config, makeDensity);
+
+    if (shooter == "density")
+        config.makeShooter = [makeDensity] { return makeDensity(DensityShooter::Aim::Parts); };
+    else if (shooter == "heads")
+        config.makeShooter = [makeDensity] { return makeDensity(DensityShooter::Aim::Heads); };
+    else if (shooter == "hunt")
+        config.makeShooter = [] { return std::make_unique<HuntShooter>(); };
+    else if (shooter == "random")
+        config.makeShooter = [] { return std::make_unique<RandomShooter>(); };
+    else {
+        printUsage();
+        return 1;
+    }
+
+    SimulationRunner runner(config);
+    SimulationResult result = runner.run();
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "games:        " << result.games << " (" << result.completed << " finished, "
+        << result.games - result.completed << " not placed or not finished)\n"
+        << "board:        " << config.boardSize << "x" << config.boardSize << ", " << config.maxShips << " planes, shooter " << shooter << "\n"
+        << "seed:         " << config.seed << "\n"
+        << "time:         " << result.seconds * 1000.0 << " ms\n"
+        << "games/sec:    " << result.gamesPerSecond() << "\n"
+        << "shots/sec:    " << result.shotsPerSecond() << "\n"
+        << "player 1 won: " << result.player1Wins << "\n";
+
+    if (result.completed > 0) {
+        std::cout << "shots to win: mean " << result.meanShotsToWin()
+            << ", p50 " << result.shotsToWinPercentile(0.50)
+            << ", p90 " << result.shotsToWinPercentile(0.90)
+            << ", p99 " << result.shotsToWinPercentile(0.99) << "\n\n";
+        printHistogram(result);
+    }
 
     return 0;
 }
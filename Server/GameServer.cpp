@@ -0,0 +1,150 @@
+#include "GameServer.h"
+#include <cstring>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int LISTEN_BACKLOG = 1024;
+}
+
+GameServer::GameServer(ServerConfig config)
+    : m_config(std::move(config))
+{
+}
+
+GameServer::~GameServer()
+{
+    stop();
+}
+
+bool GameServer::start()
+{
+    if (!m_shards.empty() || m_config.maxShips < 1 || m_config.maxShips > MAX_SHIPS)
+        return false;
+
+    int count = m_config.shards;
+    if (count <= 0)
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    if (count <= 0)
+        count = 1;
+
+    const bool useUnix = !m_config.unixPath.empty();
+    if (useUnix) {
+        m_sharedListener = openUnixListener();
+        if (m_sharedListener < 0)
+            return false;
+    }
+
+    m_port = m_config.port;
+    for (int i = 0; i < count; ++i) {
+        int listener = m_sharedListener;
+        if (!useUnix) {
+            // the first listener picks the port when none was asked for, the rest join it
+            listener = openTcpListener(m_port);
+            if (listener < 0) {
+                stop();
+                return false;
+            }
+            if (m_port == 0) {
+                sockaddr_in address{};
+                socklen_t length = sizeof(address);
+                ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+                m_port = ntohs(address.sin_port);
+            }
+        }
+
+        auto shard = std::make_unique<ServerShard>(i, m_config.maxShips, m_config.seed + static_cast<std::uint64_t>(i));
+        const bool opened = shard->open(listener, !useUnix);
+        m_shards.push_back(std::move(shard));
+        if (!opened) {
+            stop();
+            return false;
+        }
+    }
+
+    for (auto& shard : m_shards)
+        shard->start();
+    return true;
+}
+
+void GameServer::stop()
+{
+    for (auto& shard : m_shards)
+        shard->stop();
+    m_shards.clear();
+
+    if (m_sharedListener >= 0) {
+        ::close(m_sharedListener);
+        m_sharedListener = -1;
+        ::unlink(m_config.unixPath.c_str());
+    }
+}
+
+int GameServer::getPort() const
+{
+    return m_port;
+}
+
+int GameServer::getShardCount() const
+{
+    return static_cast<int>(m_shards.size());
+}
+
+ServerStats GameServer::getStats() const
+{
+    ServerStats total;
+    for (const auto& shard : m_shards) {
+        const ShardStats& stats = shard->getStats();
+        total.connections += stats.connections.load(std::memory_order_relaxed);
+        total.commands += stats.commands.load(std::memory_order_relaxed);
+        total.matchesStarted += stats.matchesStarted.load(std::memory_order_relaxed);
+        total.matchesFinished += stats.matchesFinished.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+int GameServer::openTcpListener(int port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, LISTEN_BACKLOG) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int GameServer::openUnixListener()
+{
+    sockaddr_un address{};
+    if (m_config.unixPath.size() >= sizeof(address.sun_path))
+        return -1;
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, m_config.unixPath.c_str(), m_config.unixPath.size() + 1);
+    ::unlink(m_config.unixPath.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, LISTEN_BACKLOG) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
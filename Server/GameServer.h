@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ServerShard.h"
+
+struct ServerConfig {
+    // 0 picks a free port; ignored when unixPath is set
+    int port{ 0 };
+    std::string unixPath;
+    // 0 means one shard per hardware thread
+    int shards{ 0 };
+    // 1..GameServer::MAX_SHIPS
+    int maxShips{ 3 };
+    std::uint64_t seed{ 0x5EEDu };
+};
+
+struct ServerStats {
+    std::uint64_t connections{ 0 };
+    std::uint64_t commands{ 0 };
+    std::uint64_t matchesStarted{ 0 };
+    std::uint64_t matchesFinished{ 0 };
+};
+
+// Runs matches against a bot for many clients. Every connection, and so every match, is
+// pinned to the shard that accepted it. For TCP each shard has its own SO_REUSEPORT
+// listener so the kernel spreads connections; a Unix socket is shared by all shards.
+class GameServer {
+public:
+    // The bot places its planes at random and can box itself in with more than this many.
+    static constexpr int MAX_SHIPS = 3;
+
+    explicit GameServer(ServerConfig config);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    bool start();
+    void stop();
+
+    int getPort() const;
+    int getShardCount() const;
+    ServerStats getStats() const;
+
+private:
+    int openTcpListener(int port);
+    int openUnixListener();
+
+    ServerConfig m_config;
+    int m_port{ 0 };
+    std::vector<std::unique_ptr<ServerShard>> m_shards;
+    int m_sharedListener{ -1 };
+};
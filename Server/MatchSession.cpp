@@ -0,0 +1,151 @@
+#include "MatchSession.h"
+#include "GameFactory.h"
+#include "Ship.h"
+
+using Protocol::ErrorCode;
+using Protocol::Frame;
+using Protocol::FrameType;
+
+MatchSession::MatchSession(int maxShips, std::uint64_t seed, ShardStats& stats)
+    : m_maxShips(maxShips), m_stats(stats), m_rng{ seed }
+{
+}
+
+bool MatchSession::handle(const Frame& frame, std::vector<std::uint8_t>& out)
+{
+    switch (frame.type) {
+    case FrameType::NewMatch:
+        newMatch(frame.seed ? frame.seed : m_rng.next(), out);
+        return true;
+    case FrameType::PlaceShip:
+        place(frame, out);
+        return true;
+    case FrameType::Shoot:
+        shoot(frame, out);
+        return true;
+    case FrameType::Quit: {
+        Frame bye;
+        bye.type = FrameType::Bye;
+        Protocol::encode(bye, out);
+        return false;
+    }
+    default:
+        // server -> client frames have no business arriving here
+        Protocol::encode(Protocol::error(ErrorCode::UnknownType, frame.type), out);
+        return true;
+    }
+}
+
+void MatchSession::newMatch(std::uint64_t seed, std::vector<std::uint8_t>& out)
+{
+    if (!m_game) {
+        GameFactory factory("Client", "Server", GameFactory::CLASSIC_BOARD_SIZE, m_maxShips);
+        m_game = factory.create();
+    }
+    m_game->startGame();
+    m_rng = SplitMix64{ seed };
+    m_botShooter.reset(m_game->getGridSize());
+    m_placed = 0;
+    m_started = false;
+    m_finished = false;
+    m_stats.matchesStarted.fetch_add(1, std::memory_order_relaxed);
+
+    Frame started;
+    started.type = FrameType::MatchStarted;
+    started.boardSize = static_cast<std::uint8_t>(m_game->getGridSize());
+    started.count = static_cast<std::uint8_t>(m_maxShips);
+    Protocol::encode(started, out);
+}
+
+void MatchSession::place(const Frame& frame, std::vector<std::uint8_t>& out)
+{
+    if (!m_game || m_started || m_finished) {
+        Protocol::encode(Protocol::error(ErrorCode::NotPlacing, frame.type), out);
+        return;
+    }
+    if (!m_game->placeShip(Position(frame.x, frame.y), Ship::PART_COUNT, frame.orientation)) {
+        Protocol::encode(Protocol::error(ErrorCode::CannotPlace, frame.type), out);
+        return;
+    }
+
+    ++m_placed;
+    Frame placed = frame;
+    placed.type = FrameType::ShipPlaced;
+    placed.count = static_cast<std::uint8_t>(m_placed);
+    Protocol::encode(placed, out);
+
+    if (m_placed == m_maxShips) {
+        m_game->switchTurn();
+        if (!botPlaces()) {
+            // the match cannot go on; only a NewMatch is served after this
+            m_finished = true;
+            Protocol::encode(Protocol::error(ErrorCode::NotPlaying, frame.type), out);
+            return;
+        }
+        m_game->switchTurn();
+        m_started = true;
+
+        Frame inProgress;
+        inProgress.type = FrameType::StateChanged;
+        inProgress.state = GameState::InProgress;
+        Protocol::encode(inProgress, out);
+    }
+}
+
+void MatchSession::shoot(const Frame& frame, std::vector<std::uint8_t>& out)
+{
+    if (!m_started || m_finished) {
+        Protocol::encode(Protocol::error(ErrorCode::NotPlaying, frame.type), out);
+        return;
+    }
+
+    const Position target(frame.x, frame.y);
+    const int size = m_game->getGridSize();
+    if (frame.x >= size || frame.y >= size) {
+        Protocol::encode(Protocol::error(ErrorCode::OutsideBoard, frame.type), out);
+        return;
+    }
+    const CellState before = m_game->getPlayer2()->getBoard()->getCellState(target);
+    if (before == CellState::Hit || before == CellState::Miss) {
+        Protocol::encode(Protocol::error(ErrorCode::AlreadyShot, frame.type), out);
+        return;
+    }
+
+    Cell cell;
+    fire(target, 0, out, cell);
+    if (m_finished)
+        return;
+
+    fire(m_botShooter.nextShot(m_rng), 1, out, cell);
+    m_botShooter.onShotResult(cell);
+}
+
+void MatchSession::fire(const Position& position, int player, std::vector<std::uint8_t>& out, Cell& cell)
+{
+    auto target = player == 0 ? m_game->getPlayer2() : m_game->getPlayer1();
+    m_game->shoot(position);
+    cell = target->getBoard()->getCellInfo(position);
+
+    if (m_game->isGameOver()) {
+        m_finished = true;
+        m_stats.matchesFinished.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Frame shot;
+    shot.type = FrameType::ShotFired;
+    shot.x = static_cast<std::uint8_t>(position.m_x);
+    shot.y = static_cast<std::uint8_t>(position.m_y);
+    shot.player = static_cast<std::uint8_t>(player);
+    shot.hit = cell.state == CellState::Hit;
+    shot.head = shot.hit && cell.isHead;
+    shot.state = m_finished ? GameState::GameOver : GameState::InProgress;
+    Protocol::encode(shot, out);
+}
+
+bool MatchSession::botPlaces()
+{
+    auto tryPlace = [this](const Ship& plane) {
+        return m_game->placeShip(plane.getHead(), Ship::PART_COUNT, plane.getOrientation());
+    };
+    return m_botPlacement.placeShips(m_game->getGridSize(), m_maxShips, tryPlace, m_rng);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "IGame.h"
+#include "Protocol.h"
+#include "RandomStrategies.h"
+#include "SplitMix64.h"
+
+// Counters a shard keeps for its sessions. Only the shard thread writes them.
+struct ShardStats {
+    std::atomic<std::uint64_t> connections{ 0 };
+    std::atomic<std::uint64_t> commands{ 0 };
+    std::atomic<std::uint64_t> matchesStarted{ 0 };
+    std::atomic<std::uint64_t> matchesFinished{ 0 };
+};
+
+// One client's match against a server bot, driven by Protocol frames:
+//   NewMatch   -> MatchStarted (a zero seed lets the server pick one)
+//   PlaceShip  -> ShipPlaced, plus StateChanged(InProgress) once the bot has placed too
+//   Shoot      -> ShotFired for the client's shot, then ShotFired for the bot's answer
+//                 unless the first one ended the match (its state is GameOver)
+//   Quit       -> Bye, then the connection closes
+// A command that cannot be served gets a single Error frame. If the bot cannot place its
+// planes the last PlaceShip gets Error(NotPlaying) and the match is over until the next
+// NewMatch. Sessions live on one shard and are never shared.
+class MatchSession {
+public:
+    MatchSession(int maxShips, std::uint64_t seed, ShardStats& stats);
+
+    // Appends the reply to out; false when the connection should close after it.
+    bool handle(const Protocol::Frame& frame, std::vector<std::uint8_t>& out);
+
+private:
+    void newMatch(std::uint64_t seed, std::vector<std::uint8_t>& out);
+    void place(const Protocol::Frame& frame, std::vector<std::uint8_t>& out);
+    void shoot(const Protocol::Frame& frame, std::vector<std::uint8_t>& out);
+    // Fires at position for the current player and appends its ShotFired frame.
+    void fire(const Position& position, int player, std::vector<std::uint8_t>& out, Cell& cell);
+    bool botPlaces();
+
+    int m_maxShips;
+    ShardStats& m_stats;
+    std::unique_ptr<IGame> m_game;
+    RandomPlacement m_botPlacement;
+    HuntShooter m_botShooter;
+    SplitMix64 m_rng;
+    int m_placed{ 0 };
+    bool m_started{ false };
+    bool m_finished{ false };
+};
@@ -0,0 +1,293 @@
+#include "ServerShard.h"
+#include <cerrno>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int MAX_EVENTS = 256;
+    constexpr std::size_t READ_CHUNK = 16 * 1024;
+    // per readiness event, so one busy client cannot hold up the rest of the shard; epoll is
+    // level triggered and reports what is left next time
+    constexpr std::size_t MAX_READ_PER_EVENT = 4 * READ_CHUNK;
+    constexpr int ACCEPT_RETRY_MS = 100;
+    // a client that stops reading its replies is not read from past this
+    constexpr std::size_t MAX_PENDING_OUTPUT = 256 * 1024;
+}
+
+ServerShard::ServerShard(int index, int maxShips, std::uint64_t seed)
+    : m_index(index), m_maxShips(maxShips), m_seed(seed)
+{
+}
+
+ServerShard::~ServerShard()
+{
+    stop();
+    for (auto& connection : m_connections) {
+        if (connection)
+            ::close(connection->fd);
+    }
+    if (m_ownsListener && m_listener >= 0)
+        ::close(m_listener);
+    if (m_wakeup >= 0)
+        ::close(m_wakeup);
+    if (m_epoll >= 0)
+        ::close(m_epoll);
+}
+
+bool ServerShard::open(int listenFd, bool ownsListener)
+{
+    m_listener = listenFd;
+    m_ownsListener = ownsListener;
+    m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll < 0 || m_wakeup < 0)
+        return false;
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeup;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event) != 0)
+        return false;
+
+    return watchListener();
+}
+
+bool ServerShard::watchListener()
+{
+    epoll_event event{};
+    event.events = EPOLLIN | (m_ownsListener ? 0u : static_cast<std::uint32_t>(EPOLLEXCLUSIVE));
+    event.data.fd = m_listener;
+    return ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listener, &event) == 0;
+}
+
+void ServerShard::start()
+{
+    m_thread = std::thread(&ServerShard::run, this);
+}
+
+void ServerShard::stop()
+{
+    if (!m_thread.joinable())
+        return;
+    std::uint64_t one = 1;
+    [[maybe_unused]] auto written = ::write(m_wakeup, &one, sizeof(one));
+    m_thread.join();
+}
+
+const ShardStats& ServerShard::getStats() const
+{
+    return m_stats;
+}
+
+void ServerShard::run()
+{
+    epoll_event events[MAX_EVENTS];
+    for (;;) {
+        int count = ::epoll_wait(m_epoll, events, MAX_EVENTS, m_acceptPaused ? ACCEPT_RETRY_MS : -1);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "shard " << m_index << ": epoll_wait failed (" << errno << ")\n";
+            return;
+        }
+        if (m_acceptPaused && std::chrono::steady_clock::now() >= m_acceptResume) {
+            m_acceptPaused = false;
+            watchListener();
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == m_wakeup)
+                return;
+            if (fd == m_listener) {
+                acceptAll();
+                continue;
+            }
+
+            Connection* connection = fd < static_cast<int>(m_connections.size()) ? m_connections[fd].get() : nullptr;
+            if (!connection)
+                continue;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                close(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLIN)
+                onReadable(*connection);
+            else if (events[i].events & EPOLLOUT)
+                respond(*connection);
+        }
+    }
+}
+
+void ServerShard::acceptAll()
+{
+    for (;;) {
+        int fd = ::accept4(m_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return;     // drained, or another shard took it
+            if (errno == ECONNABORTED || errno == EINTR)
+                continue;
+            std::cerr << "shard " << m_index << ": accept failed (" << errno << "), pausing\n";
+            pauseAccepting();
+            return;
+        }
+
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+
+        if (fd >= static_cast<int>(m_connections.size()))
+            m_connections.resize(fd + 1);
+        const std::uint64_t seed = m_seed ^ (static_cast<std::uint64_t>(m_index) << 48) ^ static_cast<std::uint64_t>(fd);
+        m_connections[fd] = std::make_unique<Connection>(fd, m_maxShips, seed, m_stats);
+        m_stats.connections.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ServerShard::pauseAccepting()
+{
+    if (m_acceptPaused)
+        return;
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, m_listener, nullptr);
+    m_acceptPaused = true;
+    m_acceptResume = std::chrono::steady_clock::now() + std::chrono::milliseconds(ACCEPT_RETRY_MS);
+}
+
+void ServerShard::onReadable(Connection& connection)
+{
+    char buffer[READ_CHUNK];
+    for (std::size_t total = 0; total < MAX_READ_PER_EVENT;) {
+        ssize_t received = ::read(connection.fd, buffer, sizeof(buffer));
+        if (received > 0) {
+            connection.input.insert(connection.input.end(), buffer, buffer + received);
+            total += static_cast<std::size_t>(received);
+            continue;
+        }
+        if (received == 0) {
+            connection.peerClosed = true;
+            break;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            close(connection.fd);
+            return;
+        }
+        break;
+    }
+    respond(connection);
+}
+
+void ServerShard::respond(Connection& connection)
+{
+    // replies to pipelined commands go out in one write; past the cap the rest wait for the socket
+    for (;;) {
+        const bool held = serve(connection);
+        if (!flush(connection)) {
+            close(connection.fd);
+            return;
+        }
+        if (!held || connection.written < connection.output.size())
+            return;
+    }
+}
+
+bool ServerShard::serve(Connection& connection)
+{
+    std::size_t offset = 0;
+    std::uint64_t commands = 0;
+    bool held = false;
+    bool drained = false;
+    while (!connection.closing) {
+        if (connection.output.size() - connection.written > MAX_PENDING_OUTPUT) {
+            held = true;
+            break;
+        }
+        Protocol::Frame frame;
+        std::size_t consumed = 0;
+        auto result = Protocol::decode(connection.input.data() + offset, connection.input.size() - offset, frame, consumed);
+        if (result == Protocol::DecodeResult::NeedMore) {
+            drained = true;
+            break;
+        }
+        offset += consumed;
+        ++commands;
+        if (result == Protocol::DecodeResult::Ok) {
+            if (!connection.session.handle(frame, connection.output))
+                connection.closing = true;
+        }
+        else {
+            auto code = result == Protocol::DecodeResult::UnknownType ? Protocol::ErrorCode::UnknownType : Protocol::ErrorCode::Malformed;
+            Protocol::encode(Protocol::error(code, frame.type), connection.output);
+        }
+    }
+    connection.input.erase(connection.input.begin(), connection.input.begin() + static_cast<std::ptrdiff_t>(offset));
+    m_stats.commands.fetch_add(commands, std::memory_order_relaxed);
+
+    // nothing more can arrive, so once every complete frame is answered the connection is done
+    if (connection.peerClosed && drained)
+        connection.closing = true;
+    return held;
+}
+
+bool ServerShard::flush(Connection& connection)
+{
+    while (connection.written < connection.output.size()) {
+        ssize_t sent = ::send(connection.fd, connection.output.data() + connection.written,
+            connection.output.size() - connection.written, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.written += static_cast<std::size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            watch(connection);
+            return true;
+        }
+        return false;
+    }
+
+    connection.output.clear();
+    connection.written = 0;
+    watch(connection);
+    return !connection.closing;
+}
+
+void ServerShard::watch(Connection& connection)
+{
+    const std::size_t pending = connection.output.size() - connection.written;
+    const bool reads = !connection.closing && !connection.peerClosed && pending <= MAX_PENDING_OUTPUT;
+    const bool writes = pending > 0;
+    if (reads == connection.watchingReads && writes == connection.watchingWrites)
+        return;
+
+    epoll_event event{};
+    event.events = (reads ? static_cast<std::uint32_t>(EPOLLIN) : 0u) | (writes ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = connection.fd;
+    ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.watchingReads = reads;
+    connection.watchingWrites = writes;
+}
+
+void ServerShard::close(int fd)
+{
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    m_connections[fd].reset();
+    // a descriptor is free again
+    if (m_acceptPaused) {
+        m_acceptPaused = false;
+        watchListener();
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "MatchSession.h"
+
+// One event loop: an epoll set, the connections it accepted and their matches. Nothing in
+// here is shared with other shards, so serving a command never takes a lock.
+class ServerShard {
+public:
+    ServerShard(int index, int maxShips, std::uint64_t seed);
+    ~ServerShard();
+
+    ServerShard(const ServerShard&) = delete;
+    ServerShard& operator=(const ServerShard&) = delete;
+
+    // listenFd is non-blocking. With ownsListener the shard closes it; a shared Unix socket
+    // listener is added with EPOLLEXCLUSIVE so only one shard wakes per connection.
+    bool open(int listenFd, bool ownsListener);
+    void start();
+    void stop();
+
+    const ShardStats& getStats() const;
+
+private:
+    struct Connection {
+        Connection(int fd, int maxShips, std::uint64_t seed, ShardStats& stats)
+            : fd(fd), session(maxShips, seed, stats) {}
+
+        int fd;
+        std::vector<std::uint8_t> input;
+        std::vector<std::uint8_t> output;
+        std::size_t written{ 0 };
+        bool closing{ false };
+        // the client shut its side; frames it sent before that are still answered
+        bool peerClosed{ false };
+        bool watchingReads{ true };
+        bool watchingWrites{ false };
+        MatchSession session;
+    };
+
+    void run();
+    void acceptAll();
+    // Out of file descriptors the pending connection stays queued and the listener would wake
+    // the loop forever; it is left unwatched until a connection closes or a while has passed.
+    void pauseAccepting();
+    bool watchListener();
+    void onReadable(Connection& connection);
+    // Serves buffered frames and sends the replies, closing the connection when it is done.
+    void respond(Connection& connection);
+    // Replies to the complete frames in the input, stopping once MAX_PENDING_OUTPUT bytes wait
+    // to be sent; true if frames were held back.
+    bool serve(Connection& connection);
+    // Writes as much pending output as the socket takes; false when the connection is done.
+    bool flush(Connection& connection);
+    // Reads only while the client is there and its replies are under the cap, writes only
+    // while some are pending.
+    void watch(Connection& connection);
+    void close(int fd);
+
+    int m_index;
+    int m_maxShips;
+    std::uint64_t m_seed;
+    int m_epoll{ -1 };
+    int m_wakeup{ -1 };
+    int m_listener{ -1 };
+    bool m_ownsListener{ false };
+    bool m_acceptPaused{ false };
+    std::chrono::steady_clock::time_point m_acceptResume;
+    // indexed by file descriptor
+    std::vector<std::unique_ptr<Connection>> m_connections;
+    ShardStats m_stats;
+    std::thread m_thread;
+};
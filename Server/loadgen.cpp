@@ -0,0 +1,332 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "DynamicBoard.h"
+#include "GameServer.h"
+#include "Protocol.h"
+#include "RandomStrategies.h"
+#include "Ship.h"
+
+// Load generator: every connection plays full matches against the server, placing with
+// RandomPlacement and shooting with HuntShooter. Exits non-zero if any match went wrong.
+//   loadgen [--host A] [--port N] [--unix PATH] [--connections N] [--matches N per connection]
+//           [--self-host] [--shards N] [--ships N] [--pipeline N shots in flight]
+
+namespace
+{
+    struct LoadConfig {
+        std::string host{ "127.0.0.1" };
+        int port{ 7070 };
+        std::string unixPath;
+        int connections{ 8 };
+        int matches{ 100 };
+        int maxShips{ 3 };
+        // shots sent before reading any reply
+        int pipeline{ 4 };
+    };
+
+    struct LoadTotals {
+        std::atomic<std::uint64_t> commands{ 0 };
+        std::atomic<std::uint64_t> finished{ 0 };
+        std::atomic<std::uint64_t> won{ 0 };
+        std::atomic<std::uint64_t> errors{ 0 };
+    };
+
+    class FrameClient {
+    public:
+        ~FrameClient()
+        {
+            if (m_fd >= 0)
+                ::close(m_fd);
+        }
+
+        bool connect(const LoadConfig& config)
+        {
+            if (!config.unixPath.empty()) {
+                sockaddr_un address{};
+                if (config.unixPath.size() >= sizeof(address.sun_path))
+                    return false;
+                address.sun_family = AF_UNIX;
+                std::memcpy(address.sun_path, config.unixPath.c_str(), config.unixPath.size() + 1);
+                m_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                return m_fd >= 0 && ::connect(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+            }
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<std::uint16_t>(config.port));
+            if (::inet_pton(AF_INET, config.host.c_str(), &address.sin_addr) != 1)
+                return false;
+            m_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (m_fd < 0)
+                return false;
+            int one = 1;
+            ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            return ::connect(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        }
+
+        // Frames are queued and go out together on flush(), so a batch costs one round trip.
+        void queue(const Protocol::Frame& frame)
+        {
+            Protocol::encode(frame, m_pending);
+        }
+
+        bool flush()
+        {
+            std::size_t sent = 0;
+            while (sent < m_pending.size()) {
+                ssize_t n = ::send(m_fd, m_pending.data() + sent, m_pending.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0)
+                    return false;
+                sent += static_cast<std::size_t>(n);
+            }
+            m_pending.clear();
+            return true;
+        }
+
+        bool read(Protocol::Frame& frame)
+        {
+            for (;;) {
+                std::size_t consumed = 0;
+                auto result = Protocol::decode(m_buffer.data() + m_offset, m_buffer.size() - m_offset, frame, consumed);
+                if (result != Protocol::DecodeResult::NeedMore) {
+                    m_offset += consumed;
+                    return result == Protocol::DecodeResult::Ok;
+                }
+
+                m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(m_offset));
+                m_offset = 0;
+                std::uint8_t chunk[4096];
+                ssize_t n = ::read(m_fd, chunk, sizeof(chunk));
+                if (n <= 0)
+                    return false;
+                m_buffer.insert(m_buffer.end(), chunk, chunk + n);
+            }
+        }
+
+    private:
+        int m_fd{ -1 };
+        std::vector<std::uint8_t> m_pending;
+        std::vector<std::uint8_t> m_buffer;
+        std::size_t m_offset{ 0 };
+    };
+
+    bool expect(FrameClient& client, Protocol::FrameType type, Protocol::Frame& frame)
+    {
+        return client.read(frame) && frame.type == type;
+    }
+
+    // Plays one match to the end; false on any unexpected reply.
+    bool playMatch(FrameClient& client, const LoadConfig& config, std::uint64_t seed, LoadTotals& totals)
+    {
+        using Protocol::FrameType;
+
+        // the server seeds its bot with the NewMatch seed; the client plays a different stream
+        SplitMix64 rng{ ~seed };
+        Protocol::Frame reply;
+
+        client.queue(Protocol::newMatch(seed));
+        if (!client.flush() || !expect(client, FrameType::MatchStarted, reply))
+            return false;
+        totals.commands.fetch_add(1, std::memory_order_relaxed);
+        const int size = reply.boardSize;
+        const int planes = reply.count;
+
+        DynamicBoard scratch(size);
+        std::vector<Ship> fleet;
+        auto tryPlace = [&](const Ship& plane) {
+            if (!scratch.placeShip(plane))
+                return false;
+            fleet.push_back(plane);
+            return true;
+        };
+        RandomPlacement placement;
+        if (!placement.placeShips(size, planes, tryPlace, rng))
+            return false;
+
+        // the whole fleet goes out in one write
+        for (const Ship& plane : fleet)
+            client.queue(Protocol::placeShip(plane.getHead().m_x, plane.getHead().m_y, plane.getOrientation()));
+        if (!client.flush())
+            return false;
+        for (std::size_t i = 0; i < fleet.size(); ++i) {
+            if (!expect(client, FrameType::ShipPlaced, reply))
+                return false;
+        }
+        if (!expect(client, FrameType::StateChanged, reply) || reply.state != GameState::InProgress)
+            return false;
+        totals.commands.fetch_add(fleet.size(), std::memory_order_relaxed);
+
+        // shots go out config.pipeline at a time; the shooter hears the results after each batch
+        HuntShooter shooter;
+        shooter.reset(size);
+        std::vector<Position> batch;
+        for (;;) {
+            batch.clear();
+            for (int i = 0; i < config.pipeline; ++i) {
+                Position target = shooter.nextShot(rng);
+                if (target.m_x < 0)
+                    break;
+                batch.push_back(target);
+                client.queue(Protocol::shoot(target.m_x, target.m_y));
+            }
+            if (batch.empty() || !client.flush())
+                return false;
+            totals.commands.fetch_add(batch.size(), std::memory_order_relaxed);
+
+            bool over = false;
+            for (const Position& target : batch) {
+                if (over) {
+                    // shots pipelined past the end of the match
+                    if (!expect(client, FrameType::Error, reply) || reply.error != Protocol::ErrorCode::NotPlaying)
+                        return false;
+                    continue;
+                }
+
+                if (!expect(client, FrameType::ShotFired, reply) || reply.player != 0)
+                    return false;
+                shooter.onShotResult(Cell{ target, reply.hit ? CellState::Hit : CellState::Miss, reply.head });
+                if (reply.state == GameState::GameOver) {
+                    totals.won.fetch_add(1, std::memory_order_relaxed);
+                    over = true;
+                    continue;
+                }
+
+                if (!expect(client, FrameType::ShotFired, reply) || reply.player != 1)
+                    return false;
+                over = reply.state == GameState::GameOver;
+            }
+            if (over)
+                return true;
+        }
+    }
+
+    void runConnection(const LoadConfig& config, int index, LoadTotals& totals)
+    {
+        FrameClient client;
+        if (!client.connect(config)) {
+            totals.errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        for (int match = 0; match < config.matches; ++match) {
+            const std::uint64_t seed = static_cast<std::uint64_t>(index) * 1000003u + static_cast<std::uint64_t>(match);
+            if (!playMatch(client, config, seed, totals)) {
+                totals.errors.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            totals.finished.fetch_add(1, std::memory_order_relaxed);
+        }
+        Protocol::Frame quit;
+        quit.type = Protocol::FrameType::Quit;
+        client.queue(quit);
+        if (client.flush())
+            client.read(quit);
+    }
+}
+
+static void printUsage()
+{
+    std::cout << "usage: loadgen [--host A] [--port N] [--unix PATH] [--connections N] [--matches N] [--self-host] [--shards N] [--ships N] [--pipeline N]\n";
+}
+
+int main(int argc, char** argv)
+{
+    LoadConfig config;
+    bool selfHost = false;
+    int shards = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "--help")) {
+            printUsage();
+            return 0;
+        }
+        if (!std::strcmp(arg, "--self-host")) {
+            selfHost = true;
+            continue;
+        }
+        if (!value) {
+            printUsage();
+            return 1;
+        }
+        if (!std::strcmp(arg, "--host")) config.host = value;
+        else if (!std::strcmp(arg, "--port")) config.port = std::atoi(value);
+        else if (!std::strcmp(arg, "--unix")) config.unixPath = value;
+        else if (!std::strcmp(arg, "--connections")) config.connections = std::atoi(value);
+        else if (!std::strcmp(arg, "--matches")) config.matches = std::atoi(value);
+        else if (!std::strcmp(arg, "--shards")) shards = std::atoi(value);
+        else if (!std::strcmp(arg, "--ships")) config.maxShips = std::atoi(value);
+        else if (!std::strcmp(arg, "--pipeline")) config.pipeline = std::atoi(value);
+        else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (config.connections <= 0 || config.matches <= 0 || config.maxShips <= 0 || config.pipeline <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    // --self-host runs the server in this process, on loopback or the given Unix socket
+    std::unique_ptr<GameServer> server;
+    if (selfHost) {
+        ServerConfig serverConfig;
+        serverConfig.port = 0;
+        serverConfig.unixPath = config.unixPath;
+        serverConfig.shards = shards;
+        serverConfig.maxShips = config.maxShips;
+        server = std::make_unique<GameServer>(serverConfig);
+        if (!server->start()) {
+            std::cerr << "loadgen: could not start the server\n";
+            return 1;
+        }
+        config.host = "127.0.0.1";
+        config.port = server->getPort();
+    }
+
+    LoadTotals totals;
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<std::size_t>(config.connections));
+    for (int i = 0; i < config.connections; ++i)
+        threads.emplace_back(runConnection, std::cref(config), i, std::ref(totals));
+    for (auto& thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    const std::uint64_t expected = static_cast<std::uint64_t>(config.connections) * static_cast<std::uint64_t>(config.matches);
+    const std::uint64_t commands = totals.commands.load();
+    const std::uint64_t finished = totals.finished.load();
+    std::cout << std::fixed << std::setprecision(1)
+        << "matches:      " << finished << "/" << expected << " finished, " << totals.won.load() << " won by the client\n"
+        << "errors:       " << totals.errors.load() << "\n"
+        << "time:         " << seconds * 1000.0 << " ms\n"
+        << "matches/sec:  " << (seconds > 0 ? finished / seconds : 0.0) << "\n"
+        << "commands/sec: " << (seconds > 0 ? commands / seconds : 0.0) << "\n";
+
+    if (server) {
+        ServerStats stats = server->getStats();
+        std::cout << "server:       " << server->getShardCount() << " shards, " << stats.connections << " connections, "
+            << stats.matchesFinished << "/" << stats.matchesStarted << " matches finished\n";
+        server->stop();
+    }
+
+    return totals.errors.load() == 0 && finished == expected ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "GameServer.h"
+
+// Match server: every client plays against a bot over the binary Protocol frames.
+//   server [--port N] [--unix PATH] [--shards N] [--ships N] [--seed N]
+
+static void printUsage()
+{
+    std::cout << "usage: server [--port N] [--unix PATH] [--shards N] [--ships N] [--seed N]\n";
+}
+
+int main(int argc, char** argv)
+{
+    ServerConfig config;
+    config.port = 7070;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "--help")) {
+            printUsage();
+            return 0;
+        }
+        if (!value) {
+            printUsage();
+            return 1;
+        }
+        if (!std::strcmp(arg, "--port")) config.port = std::atoi(value);
+        else if (!std::strcmp(arg, "--unix")) config.unixPath = value;
+        else if (!std::strcmp(arg, "--shards")) config.shards = std::atoi(value);
+        else if (!std::strcmp(arg, "--ships")) config.maxShips = std::atoi(value);
+        else if (!std::strcmp(arg, "--seed")) config.seed = std::strtoull(value, nullptr, 10);
+        else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (config.maxShips < 1 || config.maxShips > GameServer::MAX_SHIPS) {
+        std::cerr << "server: --ships must be between 1 and " << GameServer::MAX_SHIPS << "\n";
+        return 1;
+    }
+
+    // the shards inherit the blocked mask, so the signals only ever reach sigwait below
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    GameServer server(config);
+    if (!server.start()) {
+        std::cerr << "server: could not listen\n";
+        return 1;
+    }
+    if (config.unixPath.empty())
+        std::cout << "listening on port " << server.getPort() << " with " << server.getShardCount() << " shards\n";
+    else
+        std::cout << "listening on " << config.unixPath << " with " << server.getShardCount() << " shards\n";
+
+    int received = 0;
+    sigwait(&signals, &received);
+
+    ServerStats stats = server.getStats();
+    server.stop();
+    std::cout << "connections: " << stats.connections << ", commands: " << stats.commands
+        << ", matches: " << stats.matchesFinished << "/" << stats.matchesStarted << " finished\n";
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "LayoutDatabase.h"
+
+// Writes the layout database for the classic board; run by the build, see CMakeLists.txt.
+//   layoutdb --out PATH [--planes N]
+
+static void printUsage()
+{
+    std::cout << "usage: layoutdb --out PATH [--planes N]\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::string path;
+    int planes = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            printUsage();
+            return 1;
+        }
+        if (!std::strcmp(arg, "--out")) path = value;
+        else if (!std::strcmp(arg, "--planes")) planes = std::atoi(value);
+        else {
+            printUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (path.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    if (!LayoutDatabase::write(path, planes)) {
+        std::cerr << "layoutdb: could not write " << path << "\n";
+        return 1;
+    }
+
+    LayoutDatabase database;
+    if (!database.open(path)) {
+        std::cerr << "layoutdb: " << path << " does not read back\n";
+        return 1;
+    }
+    std::cout << path << ": " << database.getLayoutCount() << " layouts of " << planes << " planes, "
+        << database.getStoredCount() << " stored up to symmetry\n";
+    return 0;
+}
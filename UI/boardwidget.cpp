@@ -2,10 +2,14 @@
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QMessageBox>
-#include <QApplication>
+#include <algorithm>
+#include "PlacementTable.h"
 
-BoardWidget::BoardWidget(QWidget* parent, bool isPlacementMode)
+BoardWidget::BoardWidget(QWidget* parent, bool isPlacementMode, int size, int shipsToPlace)
 	: QWidget(parent)
+	, boardSize(size)
+	, cellSize(std::max(MIN_CELL_SIZE, BOARD_PIXELS / size))
+	, maxShips(shipsToPlace)
 	, placementMode(isPlacementMode)
 {
 	setupBoard();
@@ -18,7 +22,7 @@ void BoardWidget::setupBoard()
 	mainLayout->setContentsMargins(10, 10, 10, 10);
 
 	QLabel* instructionLabel = new QLabel(this);
-	instructionLabel->setText(placementMode ? "Plaseaza avioanele (3 avioane)" : "Tabla de joc");
+	instructionLabel->setText(placementMode ? QString("Plaseaza avioanele (%1 avioane)").arg(maxShips) : "Tabla de joc");
 	instructionLabel->setAlignment(Qt::AlignCenter);
 	instructionLabel->setStyleSheet("font-size:14pt; font-weight:bold;");
 	mainLayout->addWidget(instructionLabel);
@@ -27,14 +31,14 @@ void BoardWidget::setupBoard()
 	gridLayout->setSpacing(2);
 	gridLayout->setContentsMargins(0, 0, 0, 0);
 
-	cells.resize(BOARD_SIZE);
-	for (int i = 0; i < BOARD_SIZE; ++i)
+	cells.resize(boardSize);
+	for (int i = 0; i < boardSize; ++i)
 	{
-		cells[i].resize(BOARD_SIZE);
-		for (int j = 0; j < BOARD_SIZE; ++j)
+		cells[i].resize(boardSize);
+		for (int j = 0; j < boardSize; ++j)
 		{
 			QPushButton* btn = new QPushButton(this);
-			btn->setFixedSize(CELL_SIZE, CELL_SIZE);
+			btn->setFixedSize(cellSize, cellSize);
 			btn->setProperty("cellX", j);
 			btn->setProperty("cellY", i);
 			btn->setStyleSheet("background-color: #ADD8E6; border:1px solid #333;");
@@ -47,7 +51,7 @@ void BoardWidget::setupBoard()
 
 	QWidget* gridContainer = new QWidget(this);
 	gridContainer->setLayout(gridLayout);
-	int gridWidth = (CELL_SIZE * BOARD_SIZE) + (2 * (BOARD_SIZE - 1));
+	int gridWidth = (cellSize * boardSize) + (2 * (boardSize - 1));
 	gridContainer->setFixedSize(gridWidth, gridWidth);
 	mainLayout->addWidget(gridContainer, 0, Qt::AlignCenter);
 
@@ -73,8 +77,8 @@ void BoardWidget::setPlacementMode(bool enabled)
 void BoardWidget::setInteractive(bool enabled)
 {
 	interactive = enabled;
-	for (int i = 0; i < BOARD_SIZE; ++i)
-		for (int j = 0; j < BOARD_SIZE; ++j)
+	for (int i = 0; i < boardSize; ++i)
+		for (int j = 0; j < boardSize; ++j)
 			cells[i][j]->setEnabled(enabled);
 }
 
@@ -109,17 +113,15 @@ void BoardWidget::onCellClicked()
 		return;
 	int x = btn->property("cellX").toInt();
 	int y = btn->property("cellY").toInt();
-	if (placementMode && placedCount < 3)
+	if (placementMode && placedCount < maxShips)
 	{
 		clearPreview();
-		Position headPos(x, y);
-		Ship newShip(headPos, currentOrientation);
-		if (!canPlaceShip(newShip))
+		if (!canPlaceShipAt(x, y))
 		{
 			QMessageBox::warning(this, "Pozitie invalida", "Avionul se suprapune cu alt avion sauiese din tabla!");
 			return;
 		}
-		emit shipPlaced(newShip);
+		emit shipPlaced(Ship(Position(x, y), currentOrientation));
 	}
 	else
 	{
@@ -152,9 +154,17 @@ void BoardWidget::rotateCurrentShip()
 		showPreview(currentPreviewPosition.x(), currentPreviewPosition.y());
 }
 
+void BoardWidget::setView(const BoardView& boardView)
+{
+	view = boardView;
+	updateAllCells();
+	if (hasPreview)
+		showPreview(currentPreviewPosition.x(), currentPreviewPosition.y());
+}
+
 void BoardWidget::updateCell(int row, int col)
 {
-	if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE)
+	if (row < 0 || row >= boardSize || col < 0 || col >= boardSize)
 		return;
 	if (!cells[row][col])
 		return;
@@ -167,16 +177,25 @@ void BoardWidget::updateCell(int row, int col)
 
 void BoardWidget::updateAllCells()
 {
-	for (int r = 0; r < BOARD_SIZE; ++r)
-		for (int c = 0; c < BOARD_SIZE; ++c)
+	for (int r = 0; r < boardSize; ++r)
+		for (int c = 0; c < boardSize; ++c)
 			updateCell(r, c);
 }
 
-bool BoardWidget::canPlaceShip(const Ship& ship) const
+bool BoardWidget::canPlaceShipAt(int x, int y) const
 {
-	if (auto board = boardRef.lock())
-		return board->canPlaceShip(ship);
-	return false;
+	if (!view.ships)
+		return false;
+	for (const auto& offset : PlacementTable::OFFSETS[static_cast<int>(currentOrientation)])
+	{
+		int px = x + offset.x;
+		int py = y + offset.y;
+		if (px < 0 || px >= view.size || py < 0 || py >= view.size)
+			return false;
+		if (BoardView::test(view.ships, py * view.size + px))
+			return false;
+	}
+	return true;
 }
 
 int BoardWidget::confirmPlacement(const Ship& /*ship*/)
@@ -188,7 +207,7 @@ int BoardWidget::confirmPlacement(const Ship& /*ship*/)
 
 bool BoardWidget::eventFilter(QObject* obj, QEvent* event)
 {
-	if (!placementMode || placedCount >= 3)
+	if (!placementMode || placedCount >= maxShips)
 		return QWidget::eventFilter(obj, event);
 	QPushButton* btn = qobject_cast<QPushButton*>(obj);
 	if (!btn)
@@ -211,18 +230,17 @@ bool BoardWidget::eventFilter(QObject* obj, QEvent* event)
 void BoardWidget::showPreview(int x, int y)
 {
 	clearPreview();
-	Position headPos(x, y);
-	Ship previewShip(headPos, currentOrientation);
-	bool isValid = canPlaceShip(previewShip);
-	for (const auto& part : previewShip.getParts())
+	bool isValid = canPlaceShipAt(x, y);
+	const auto& offsets = PlacementTable::OFFSETS[static_cast<int>(currentOrientation)];
+	for (int i = 0; i < PlacementTable::PART_COUNT; ++i)
 	{
-		int px = part.getPosition().m_x;
-		int py = part.getPosition().m_y;
-		if (px >= 0 && px < BOARD_SIZE && py >= 0 && py < BOARD_SIZE)
+		int px = x + offsets[i].x;
+		int py = y + offsets[i].y;
+		if (px >= 0 && px < boardSize && py >= 0 && py < boardSize)
 		{
 			if (!isValid)
 				cells[py][px]->setStyleSheet("background-color: rgba(255,0,0,0.3); border:2px solid #FF0000;");
-			else if (part.isHeadPart())
+			else if (i == 0)
 				cells[py][px]->setStyleSheet("background-color: rgba(0,255,0,0.5); border:2px solid #00FF00;");
 			else
 				cells[py][px]->setStyleSheet("background-color: rgba(76,175,80,0.3); border:2px solid #4CAF50;");
@@ -235,13 +253,12 @@ void BoardWidget::clearPreview()
 {
 	if (!hasPreview)
 		return;
-	Position headPos(currentPreviewPosition.x(), currentPreviewPosition.y());
-	Ship previewShip(headPos, currentOrientation);
-	for (const auto& part : previewShip.getParts())
+	const auto& offsets = PlacementTable::OFFSETS[static_cast<int>(currentOrientation)];
+	for (const auto& offset : offsets)
 	{
-		int px = part.getPosition().m_x;
-		int py = part.getPosition().m_y;
-		if (px >= 0 && px < BOARD_SIZE && py >= 0 && py < BOARD_SIZE)
+		int px = currentPreviewPosition.x() + offset.x;
+		int py = currentPreviewPosition.y() + offset.y;
+		if (px >= 0 && px < boardSize && py >= 0 && py < boardSize)
 			updateCell(py, px);
 	}
 	hasPreview = false;
@@ -249,24 +266,21 @@ void BoardWidget::clearPreview()
 
 QString BoardWidget::getCellColor(int x, int y) const
 {
-	if (auto board = boardRef.lock())
+	if (!view.states || x >= view.size || y >= view.size)
+		return "#ADD8E6";
+
+	switch (view.stateAt(x, y))
 	{
-		Cell info = board->getCellInfo(Position(x, y));
-		switch (info.state)
-		{
-		case CellState::Empty:
-			return "#ADD8E6";
-		case CellState::Ship:
-			return (showShipsEnabled && !isEnemyBoard) ? "#808080" : "#ADD8E6";
-		case CellState::Hit:
-			return info.isHead ? "#8B0000" : "#FF4444";
-		case CellState::HeadHit:
-			return "#8B0000";
-		case CellState::Miss:
-			return "#FFFFFF";
-		}
+	case CellState::Empty:
 		return "#ADD8E6";
+	case CellState::Ship:
+		return (showShipsEnabled && !isEnemyBoard) ? "#808080" : "#ADD8E6";
+	case CellState::Hit:
+		return view.isHead(x, y) ? "#8B0000" : "#FF4444";
+	case CellState::HeadHit:
+		return "#8B0000";
+	case CellState::Miss:
+		return "#FFFFFF";
 	}
-
 	return "#ADD8E6";
-}
\ No newline at end of file
+}
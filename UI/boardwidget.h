@@ -11,24 +11,26 @@
 #include "Orientation.h"
 #include "Ship.h"
 #include "Position.h"
-#include "IBoard.h"
+#include "BoardView.h"
+#include "GameFactory.h"
 
 class BoardWidget : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit BoardWidget(QWidget* parent = nullptr, bool isPlacementMode = true);
+    explicit BoardWidget(QWidget* parent = nullptr, bool isPlacementMode = true,
+        int size = GameFactory::CLASSIC_BOARD_SIZE, int shipsToPlace = GameFactory::CLASSIC_MAX_SHIPS);
 
     void setPlacementMode(bool enabled);
     void setInteractive(bool enabled);
     void showShips(bool show);
     void reset();
 
-    bool allShipsPlaced() const { return placedCount >= 3; }
+    bool allShipsPlaced() const { return placedCount >= maxShips; }
     void setEnemyBoard(bool isEnemy) { isEnemyBoard = isEnemy; }
-    void setBoard(std::shared_ptr<IBoard> board) { boardRef = board; }
-    std::shared_ptr<IBoard> getBoard() const { return boardRef.lock(); }
+    // Draws from view until the next call; the view must outlive that (GameUI passes frame views).
+    void setView(const BoardView& boardView);
 
     void markHit(int x, int y, bool isHead);
     void markMiss(int x, int y);
@@ -51,13 +53,17 @@ private:
     void setupBoard();
     void updateCell(int row, int col);
     void updateAllCells();
-    bool canPlaceShip(const Ship& ship) const;
+    bool canPlaceShipAt(int x, int y) const;
     QString getCellColor(int x, int y) const;
     void clearPreview();
     void showPreview(int x, int y);
 
-    static constexpr int BOARD_SIZE = 10;
-    static constexpr int CELL_SIZE = 40;
+    static constexpr int BOARD_PIXELS = 400;
+    static constexpr int MIN_CELL_SIZE = 14;
+
+    int boardSize;
+    int cellSize;
+    int maxShips;
 
     QVector<QVector<QPushButton*>> cells;
 
@@ -74,5 +80,5 @@ private:
     QPushButton* rotateButton{ nullptr };
 
     int placedCount{ 0 };
-    std::weak_ptr<IBoard> boardRef;
+    BoardView view;
 };
\ No newline at end of file
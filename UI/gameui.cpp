@@ -1,80 +1,104 @@
 #include "gameui.h"
 #include <QMessageBox>
-#include <QApplication>
-#include "IBoard.h"
-#include "IPlayer.h"
+#include <vector>
 #include "Position.h"
 #include "Ship.h"
 #include "qt_helpers.h"
-#include "PositionUtils.h"
 #include <iostream>
 
 GameUI::GameUI(std::unique_ptr<IGame> gameInstance, QWidget* parent)
 	: QWidget(parent)
+	, boardSize(gameInstance->getGridSize())
+	, maxShips(gameInstance->getMaxShips())
+	, worker(std::make_unique<GameWorker>(std::move(gameInstance)))
 	, isTransitioning(false)
-	, game(std::move(gameInstance))
 {
-	player1 = game->getPlayer1();
-	player2 = game->getPlayer2();
-
-	listenerPtr = std::shared_ptr<IGameListener>(this, [](IGameListener*) {});
-	game->addListener(listenerPtr);
-
 	setupUI();
-	game->startGame();
 
-	player1PlacementBoard->setBoard(player1->getBoard());
-	player2PlacementBoard->setBoard(player2->getBoard());
-	player1OwnBoard->setBoard(player1->getBoard());
-	player2OwnBoard->setBoard(player2->getBoard());
-	player1EnemyBoard->setBoard(player2->getBoard());
-	player2EnemyBoard->setBoard(player1->getBoard());
+	worker->start();
+	send({ GameCommandType::Start });
 
-	updateUIForCurrentState();
-}
+	frameTimer = new QTimer(this);
+	connect(frameTimer, &QTimer::timeout, this, &GameUI::onFrame);
+	frameTimer->start(FRAME_INTERVAL_MS);
 
-GameUI::~GameUI() {}
+	updateUIForState(GameState::PlacingShips, 0);
+}
 
-void GameUI::onShipPlaced(const Ship&)
+GameUI::~GameUI()
 {
-	updateUIForCurrentState();
+	worker->stop();
 }
 
-void GameUI::onShotFired(const Cell& cell, GameState)
+void GameUI::onFrame()
 {
-	auto currentPlayer = game->getCurrentPlayer().lock();
-	std::shared_ptr<IBoard> targetBoard = (currentPlayer == player1) ? player2->getBoard() : player1->getBoard();
-
-	bool isHead = false;
-	if (cell.state == CellState::Hit && targetBoard)
-	{
-		Cell info = targetBoard->getCellInfo(cell.position);
-		isHead = info.isHead;
-	}
+	// take the whole batch first: a message box below runs a nested event loop that fires the timer again
+	std::vector<WorkerMessage> messages;
+	worker->drainMessages([&messages](const WorkerMessage& message) { messages.push_back(message); });
 
-	auto syncAll = [this]() {
-		syncBoardDisplay(player1OwnBoard, player1->getBoard(), true);
-		syncBoardDisplay(player2OwnBoard, player2->getBoard(), true);
-		syncBoardDisplay(player1EnemyBoard, player2->getBoard(), false);
-		syncBoardDisplay(player2EnemyBoard, player1->getBoard(), false);
-		};
-	syncAll();
+	if (worker->updateFrame())
+		renderFrame();
 
-	QApplication::processEvents();
+	for (const auto& message : messages)
+		handleMessage(message);
 }
 
-void GameUI::onGameStateChanged(GameState newState)
+void GameUI::handleMessage(const WorkerMessage& message)
 {
-	if (newState == GameState::GameOver)
+	if (message.kind == WorkerMessage::Kind::PlacementRejected)
 	{
-		if (!player1->hasRemainingShips())
-			showGameOverMessage("Jucator2");
-		else if (!player2->hasRemainingShips())
-			showGameOverMessage("Jucator1");
+		--pendingPlacements;
+		QMessageBox::warning(this, "Eroare", "Nu s-a putut plasa avionul in Logic!");
+		return;
 	}
-	else
+	if (message.kind == WorkerMessage::Kind::MatchAborted)
+	{
+		if (gameOverShown)
+			return;
+		gameOverShown = true;
+		frameTimer->stop();
+
+		QMessageBox::warning(this, "Eroare", "Calculatorul nu si-a putut plasa avioanele, jocul s-a oprit.");
+		close();
+		return;
+	}
+
+	const GameEvent& event = message.event;
+	switch (event.type)
+	{
+	case GameEventType::ShipPlaced:
 	{
-		updateUIForCurrentState();
+		--pendingPlacements;
+		BoardWidget* source = (event.player == 0) ? player1PlacementBoard : player2PlacementBoard;
+		QPushButton* doneButton = (event.player == 0) ? player1DoneButton : player2DoneButton;
+		if (source->confirmPlacement(Ship(Position(event.x, event.y), event.orientation)) >= maxShips)
+			doneButton->setEnabled(true);
+		updateUIForState(event.state, event.player);
+		break;
+	}
+	case GameEventType::ShotFired:
+	case GameEventType::TurnSwitched:
+		// the boards and the turn are redrawn from the frame
+		break;
+	case GameEventType::StateChanged:
+		if (event.state == GameState::GameOver)
+		{
+			// the turn does not pass on the winning shot
+			showGameOverMessage(event.player == 0 ? "Jucator1" : "Jucator2");
+		}
+		else
+		{
+			updateUIForState(event.state, event.player);
+			if (event.state == GameState::SwitchingTurn)
+			{
+				// the shooter only gets to end the turn
+				BoardWidget* enemyBoard = (event.player == 0) ? player1EnemyBoard : player2EnemyBoard;
+				QPushButton* endTurnButton = (event.player == 0) ? player1EndTurnButton : player2EndTurnButton;
+				endTurnButton->setEnabled(true);
+				enemyBoard->setInteractive(false);
+			}
+		}
+		break;
 	}
 }
 
@@ -102,7 +126,7 @@ void GameUI::createPlacementScreen()
 	p1Label->setAlignment(Qt::AlignCenter);
 	p1Layout->addWidget(p1Label);
 
-	player1PlacementBoard = new BoardWidget(player1PlacementWidget, true);
+	player1PlacementBoard = new BoardWidget(player1PlacementWidget, true, boardSize, maxShips);
 	p1Layout->addWidget(player1PlacementBoard, 0, Qt::AlignCenter);
 
 	player1DoneButton = createStyledButton(player1PlacementWidget, "Gata - Treci la Jucator2",
@@ -123,7 +147,7 @@ void GameUI::createPlacementScreen()
 	p2Label->setAlignment(Qt::AlignCenter);
 	p2Layout->addWidget(p2Label);
 
-	player2PlacementBoard = new BoardWidget(player2PlacementWidget, true);
+	player2PlacementBoard = new BoardWidget(player2PlacementWidget, true, boardSize, maxShips);
 	p2Layout->addWidget(player2PlacementBoard, 0, Qt::AlignCenter);
 
 	player2DoneButton = createStyledButton(player2PlacementWidget, "Gata - Incepe Jocul",
@@ -175,7 +199,7 @@ void GameUI::createGameScreen()
 	p1OwnLabel->setAlignment(Qt::AlignCenter);
 	p1OwnLayout->addWidget(p1OwnLabel);
 
-	player1OwnBoard = new BoardWidget(player1GameWidget, false);
+	player1OwnBoard = new BoardWidget(player1GameWidget, false, boardSize, maxShips);
 	player1OwnBoard->setInteractive(false);
 	player1OwnBoard->setEnemyBoard(false);
 	p1OwnLayout->addWidget(player1OwnBoard);
@@ -186,7 +210,7 @@ void GameUI::createGameScreen()
 	p1EnemyLabel->setAlignment(Qt::AlignCenter);
 	p1EnemyLayout->addWidget(p1EnemyLabel);
 
-	player1EnemyBoard = new BoardWidget(player1GameWidget, false);
+	player1EnemyBoard = new BoardWidget(player1GameWidget, false, boardSize, maxShips);
 	player1EnemyBoard->setEnemyBoard(true);
 	player1EnemyBoard->showShips(false);
 	connect(player1EnemyBoard, &BoardWidget::cellClicked, this, &GameUI::onPlayer1CellClicked);
@@ -220,7 +244,7 @@ void GameUI::createGameScreen()
 	p2OwnLabel->setAlignment(Qt::AlignCenter);
 	p2OwnLayout->addWidget(p2OwnLabel);
 
-	player2OwnBoard = new BoardWidget(player2GameWidget, false);
+	player2OwnBoard = new BoardWidget(player2GameWidget, false, boardSize, maxShips);
 	player2OwnBoard->setInteractive(false);
 	player2OwnBoard->setEnemyBoard(false);
 	p2OwnLayout->addWidget(player2OwnBoard);
@@ -231,7 +255,7 @@ void GameUI::createGameScreen()
 	p2EnemyLabel->setAlignment(Qt::AlignCenter);
 	p2EnemyLayout->addWidget(p2EnemyLabel);
 
-	player2EnemyBoard = new BoardWidget(player2GameWidget, false);
+	player2EnemyBoard = new BoardWidget(player2GameWidget, false, boardSize, maxShips);
 	player2EnemyBoard->setEnemyBoard(true);
 	player2EnemyBoard->showShips(false);
 	connect(player2EnemyBoard, &BoardWidget::cellClicked, this, &GameUI::onPlayer2CellClicked);
@@ -252,13 +276,14 @@ void GameUI::createGameScreen()
 
 void GameUI::onPlayer1ShipsPlaced()
 {
-	if (player1->allShipsPlaced(game->getMaxShips()))
+	if (player1PlacementBoard->getPlacedCount() >= maxShips)
 	{
+		if (!send({ GameCommandType::SwitchTurn }))
+			return;
+
 		isTransitioning = true;
 
 		showTransitionScreen("Trece laptopul la Jucator2");
-
-		game->switchTurn();
 	}
 	else
 	{
@@ -268,18 +293,14 @@ void GameUI::onPlayer1ShipsPlaced()
 
 void GameUI::onPlayer2ShipsPlaced()
 {
-	if (player2->allShipsPlaced(game->getMaxShips()))
+	if (player2PlacementBoard->getPlacedCount() >= maxShips)
 	{
-		isTransitioning = true;
+		if (!send({ GameCommandType::SwitchTurn }))
+			return;
 
-		syncBoardDisplay(player1OwnBoard, player1->getBoard(), true);
-		syncBoardDisplay(player2OwnBoard, player2->getBoard(), true);
-		syncBoardDisplay(player1EnemyBoard, player2->getBoard(), false);
-		syncBoardDisplay(player2EnemyBoard, player1->getBoard(), false);
+		isTransitioning = true;
 
 		showTransitionScreen("Gata! Treci laptopul la Jucator1 pentru a incepe");
-
-		game->switchTurn();
 	}
 	else
 	{
@@ -295,13 +316,15 @@ void GameUI::onContinueButtonClicked()
 
 void GameUI::onEndTurnButtonClicked()
 {
-	auto currentPlayer = game->getCurrentPlayer().lock();
-	if (currentPlayer == player1)
+	onFrame();
+
+	int currentPlayer = worker->getFrame().turn;
+	if (currentPlayer == 0)
 	{
 		player1EnemyBoard->setInteractive(false);
 		player1EndTurnButton->setEnabled(false);
 	}
-	else if (currentPlayer == player2)
+	else
 	{
 		player2EnemyBoard->setInteractive(false);
 		player2EndTurnButton->setEnabled(false);
@@ -312,93 +335,98 @@ void GameUI::onEndTurnButtonClicked()
 
 void GameUI::onPlayer1CellClicked(int x, int y)
 {
-	auto currentPlayer = game->getCurrentPlayer().lock();
-	if (currentPlayer != player1)
-		return;
-
-	Position shotPos(x, y);
-	CellState cellState = player2->getBoard()->getCellState(shotPos);
-	if (cellState == CellState::Hit || cellState == CellState::Miss)
-	{
-		QMessageBox::information(this, "Celula deja atacata", "Ai atacat deja aceasta celula!");
-		return;
-	}
-
-	game->shoot(shotPos);
-	syncBoardDisplay(player1EnemyBoard, player2->getBoard(), false);
-	QApplication::processEvents();
-	player1EndTurnButton->setEnabled(true);
-	player1EnemyBoard->setInteractive(false);
+	shootFrom(0, x, y);
 }
 
 void GameUI::onPlayer2CellClicked(int x, int y)
 {
-	auto currentPlayer = game->getCurrentPlayer().lock();
-	if (currentPlayer != player2)
+	shootFrom(1, x, y);
+}
+
+void GameUI::shootFrom(int player, int x, int y)
+{
+	const GameFrame& frame = worker->getFrame();
+	if (frame.turn != player)
 		return;
 
-	Position shotPos(x, y);
-	CellState cellState = player1->getBoard()->getCellState(shotPos);
-	if (cellState == CellState::Hit || cellState == CellState::Miss)
+	BoardView target = frame.boards[1 - player].view();
+	if (target.states)
 	{
-		QMessageBox::information(this, "Celula deja atacata", "Ai atacat deja aceasta celula!");
-		return;
+		CellState cellState = target.stateAt(x, y);
+		if (cellState == CellState::Hit || cellState == CellState::Miss)
+		{
+			QMessageBox::information(this, "Celula deja atacata", "Ai atacat deja aceasta celula!");
+			return;
+		}
 	}
 
-	game->shoot(shotPos);
-	syncBoardDisplay(player2EnemyBoard, player1->getBoard(), false);
-	QApplication::processEvents();
-	player2EndTurnButton->setEnabled(true);
-	player2EnemyBoard->setInteractive(false);
+	// no second shot while this one is on its way
+	BoardWidget* enemyBoard = (player == 0) ? player1EnemyBoard : player2EnemyBoard;
+	enemyBoard->setInteractive(false);
+
+	if (!send({ GameCommandType::Shoot, static_cast<std::int16_t>(x), static_cast<std::int16_t>(y) }))
+		enemyBoard->setInteractive(true);
 }
 
-void GameUI::syncBoardDisplay(BoardWidget* boardWidget, std::shared_ptr<IBoard> board, bool showShips)
+void GameUI::renderFrame()
 {
-	if (!boardWidget || !board)
-		return;
-
-	boardWidget->setBoard(board);
-	boardWidget->showShips(showShips);
-	QApplication::processEvents();
+	const GameFrame& frame = worker->getFrame();
+	const BoardView board1 = frame.boards[0].view();
+	const BoardView board2 = frame.boards[1].view();
+
+	player1PlacementBoard->setView(board1);
+	player2PlacementBoard->setView(board2);
+	player1OwnBoard->setView(board1);
+	player2OwnBoard->setView(board2);
+	player1EnemyBoard->setView(board2);
+	player2EnemyBoard->setView(board1);
 }
 
 void GameUI::showGameOverMessage(const QString& winner)
 {
+	if (gameOverShown)
+		return;
+	gameOverShown = true;
+	frameTimer->stop();
+
 	QMessageBox::information(this, "Joc Terminat!", QString("Castigator: %1!\n\nToate avioanele au fost distruse.").arg(winner));
 	close();
 }
 
 void GameUI::updateUIForCurrentState()
 {
-	GameState state = game->getState();
-	auto currentPlayer = game->getCurrentPlayer().lock();
+	const GameFrame& frame = worker->getFrame();
+	updateUIForState(frame.state, frame.turn);
+}
 
+void GameUI::updateUIForState(GameState state, int currentPlayer)
+{
 	switch (state)
 	{
 	case GameState::PlacingShips:
 		if (isTransitioning)
 			return;
-		if (currentPlayer == player1)
+		if (currentPlayer == 0)
 			stackedWidget->setCurrentWidget(player1PlacementWidget);
-		else if (currentPlayer == player2)
+		else if (currentPlayer == 1)
 			stackedWidget->setCurrentWidget(player2PlacementWidget);
 		break;
 	case GameState::InProgress:
 	case GameState::SwitchingTurn:
 		if (isTransitioning)
 		{
-			QString playerName = (currentPlayer == player1) ? "Jucator1" : "Jucator2";
+			QString playerName = (currentPlayer == 0) ? "Jucator1" : "Jucator2";
 			showTransitionScreen("Treci laptopul la " + playerName);
 		}
 		else
 		{
-			if (currentPlayer == player1)
+			if (currentPlayer == 0)
 			{
 				stackedWidget->setCurrentWidget(player1GameWidget);
 				player1EnemyBoard->setInteractive(true);
 				player1EndTurnButton->setEnabled(false);
 			}
-			else if (currentPlayer == player2)
+			else if (currentPlayer == 1)
 			{
 				stackedWidget->setCurrentWidget(player2GameWidget);
 				player2EnemyBoard->setInteractive(true);
@@ -419,31 +447,19 @@ void GameUI::showTransitionScreen(const QString& message)
 
 void GameUI::placeShipFromWidget(BoardWidget* source, const Ship& ship)
 {
-	const auto& parts = ship.getParts();
-	if (parts.empty()) return;
-	const Position& headPos = parts[0].getPosition();
-	Orientation orient = Orientation::Up;
-	if (parts.size() > 1)
-		orient = LogicUtils::computeOrientation(headPos, parts[1].getPosition());
-
-	if (!game->placeShip(headPos, 1, orient))
-	{
-		QMessageBox::warning(this, "Eroare", "Nu s-a putut plasa avionul in Logic!");
+	// confirmed on the widget when the ShipPlaced event comes back; until then count it as pending
+	if (source->getPlacedCount() + pendingPlacements >= maxShips)
 		return;
-	}
 
-	int newCount = source->confirmPlacement(ship);
-	if (source == player1PlacementBoard)
-	{
-		if (newCount >= game->getMaxShips())
-			player1DoneButton->setEnabled(true);
-	}
-	else if (source == player2PlacementBoard)
-	{
-		if (newCount >= game->getMaxShips())
-			player2DoneButton->setEnabled(true);
-	}
+	if (send({ GameCommandType::PlaceShip, static_cast<std::int16_t>(ship.getHead().m_x),
+		static_cast<std::int16_t>(ship.getHead().m_y), ship.getOrientation() }))
+		++pendingPlacements;
+}
 
-	syncBoardDisplay(player1OwnBoard, player1->getBoard(), true);
-	syncBoardDisplay(player2OwnBoard, player2->getBoard(), true);
+bool GameUI::send(const GameCommand& command)
+{
+	if (worker->post(command))
+		return true;
+	QMessageBox::warning(this, "Ocupat", "Jocul nu poate primi comanda acum, incearca din nou.");
+	return false;
 }
\ No newline at end of file
@@ -6,15 +6,18 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <QTimer>
 #include <memory>
-#include "IGameListener.h"
 #include "IGame.h"
+#include "GameWorker.h"
 #include "GameState.h"
 #include "Position.h"
 #include "Ship.h"
 #include "boardwidget.h"
 
-class GameUI : public QWidget, public IGameListener
+// The game runs on a GameWorker thread; the UI only posts commands and, once per frame,
+// drains the worker's messages and redraws from its latest GameFrame.
+class GameUI : public QWidget
 {
     Q_OBJECT
 
@@ -22,11 +25,8 @@ public:
     explicit GameUI(std::unique_ptr<IGame> gameInstance, QWidget* parent = nullptr);
     ~GameUI() override;
 
-    void onShipPlaced(const Ship& ship) override;
-    void onShotFired(const Cell& cell, GameState gameState) override;
-    void onGameStateChanged(GameState newState) override;
-
 private slots:
+    void onFrame();
     void onPlayer1ShipsPlaced();
     void onPlayer2ShipsPlaced();
     void onContinueButtonClicked();
@@ -39,10 +39,15 @@ private:
     void createPlacementScreen();
     void createTransitionScreen();
     void createGameScreen();
+    void handleMessage(const WorkerMessage& message);
     void updateUIForCurrentState();
+    void updateUIForState(GameState state, int turn);
     void showTransitionScreen(const QString& message);
-    void syncBoardDisplay(BoardWidget* boardWidget, std::shared_ptr<IBoard> board, bool showShips);
+    void renderFrame();
     void showGameOverMessage(const QString& winner);
+    void shootFrom(int player, int x, int y);
+    // Posts the command; false, after telling the player, when the worker's queue is full.
+    bool send(const GameCommand& command);
 
     void placeShipFromWidget(BoardWidget* source, const Ship& ship);
 
@@ -68,11 +73,14 @@ private:
     QPushButton* player1EndTurnButton{ nullptr };
     QPushButton* player2EndTurnButton{ nullptr };
 
-    std::unique_ptr<IGame> game;
-    std::shared_ptr<IPlayer> player1;
-    std::shared_ptr<IPlayer> player2;
+    static constexpr int FRAME_INTERVAL_MS = 16;
 
-    std::shared_ptr<IGameListener> listenerPtr{ nullptr };
+    int boardSize;
+    int maxShips;
+    std::unique_ptr<GameWorker> worker;
+    QTimer* frameTimer{ nullptr };
+    int pendingPlacements{ 0 };
+    bool gameOverShown{ false };
 
     bool isTransitioning{ false };
 };
\ No newline at end of file
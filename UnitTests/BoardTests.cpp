@@ -117,3 +117,131 @@ TEST(BoardShotTests, RepeatedShotDoesNotChangeState)
     EXPECT_FALSE(second);
     EXPECT_EQ(b.getCellState(target), CellState::Hit);
 }
+
+TEST(BoardShotTests, HitMarksOnlyOwningPlane)
+{
+    Board b;
+    ASSERT_TRUE(b.placeShip(Ship(Position(2, 0), Orientation::Up)));
+    ASSERT_TRUE(b.placeShip(Ship(Position(7, 0), Orientation::Up)));
+
+    Position target = b.getShips()[1].getParts()[4].getPosition();
+    EXPECT_TRUE(b.receiveShot(target));
+
+    const auto& first = b.getShips()[0].getParts();
+    const auto& second = b.getShips()[1].getParts();
+    for (const auto& part : first)
+        EXPECT_FALSE(part.isHit());
+    EXPECT_TRUE(second[4].isHit());
+    EXPECT_FALSE(second[0].isHit());
+}
+
+TEST(BoardJournalTests, UndoRestoresHitAndMiss)
+{
+    Board b;
+    Ship s(Position(4, 4), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+
+    Position body = s.getParts()[3].getPosition();
+    EXPECT_TRUE(b.receiveShot(body));
+    EXPECT_FALSE(b.receiveShot(Position(0, 0)));
+    EXPECT_EQ(b.getJournalSize(), 2);
+
+    EXPECT_TRUE(b.undoShot());
+    EXPECT_EQ(b.getCellState(Position(0, 0)), CellState::Empty);
+    EXPECT_TRUE(b.undoShot());
+    EXPECT_EQ(b.getCellState(body), CellState::Ship);
+    EXPECT_EQ(b.getShips()[0].getHitMask(), 0);
+    EXPECT_FALSE(b.undoShot());
+}
+
+TEST(BoardJournalTests, UndoHeadShotRevivesPlane)
+{
+    Board b;
+    Ship s(Position(4, 4), Orientation::Down);
+    ASSERT_TRUE(b.placeShip(s));
+
+    b.receiveShot(s.getParts()[2].getPosition());
+    b.receiveShot(s.getHead());
+    EXPECT_TRUE(b.allShipsSunk());
+
+    EXPECT_TRUE(b.undoShot());
+    EXPECT_FALSE(b.allShipsSunk());
+    EXPECT_EQ(b.getCellState(s.getHead()), CellState::Ship);
+    EXPECT_EQ(b.getShips()[0].getHitMask(), 1 << 2);
+}
+
+TEST(BoardJournalTests, RepeatedShotUndoKeepsEarlierShot)
+{
+    Board b;
+    Ship s(Position(4, 4), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+
+    Position body = s.getParts()[5].getPosition();
+    b.receiveShot(body);
+    b.receiveShot(body);
+
+    EXPECT_TRUE(b.undoShot());
+    EXPECT_EQ(b.getCellState(body), CellState::Hit);
+}
+
+TEST(BoardHashTests, ObservationHashIsOrderIndependent)
+{
+    Ship s(Position(4, 4), Orientation::Up);
+    Board a;
+    Board b;
+    ASSERT_TRUE(a.placeShip(s));
+    ASSERT_TRUE(b.placeShip(s));
+    EXPECT_EQ(a.getLayoutHash(), b.getLayoutHash());
+    EXPECT_NE(a.getLayoutHash(), 0u);
+    EXPECT_EQ(a.getObservationHash(), 0u);
+
+    a.receiveShot(Position(0, 0));
+    a.receiveShot(s.getHead());
+    b.receiveShot(s.getHead());
+    b.receiveShot(Position(0, 0));
+    EXPECT_EQ(a.getObservationHash(), b.getObservationHash());
+}
+
+TEST(BoardHashTests, UndoRestoresObservationHash)
+{
+    Board b;
+    Ship s(Position(4, 4), Orientation::Right);
+    ASSERT_TRUE(b.placeShip(s));
+    b.receiveShot(Position(0, 9));
+    const auto before = b.getObservationHash();
+
+    b.receiveShot(s.getParts()[6].getPosition());
+    b.receiveShot(s.getHead());
+    b.receiveShot(Position(9, 0));
+    EXPECT_NE(b.getObservationHash(), before);
+
+    b.undoShot();
+    b.undoShot();
+    b.undoShot();
+    EXPECT_EQ(b.getObservationHash(), before);
+}
+
+TEST(BoardShotTests, ReceiveShotsReportsBatch)
+{
+    Board b;
+    Ship first(Position(2, 0), Orientation::Up);
+    Ship second(Position(7, 0), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(first));
+    ASSERT_TRUE(b.placeShip(second));
+
+    const Position shots[] = {
+        first.getParts()[2].getPosition(),  // body hit
+        Position(0, 9),                     // miss
+        second.getHead(),                   // head kill
+        Position(0, 9),                     // repeated
+        Position(-1, 3)                     // invalid
+    };
+    auto result = b.receiveShots(shots);
+
+    EXPECT_EQ(result.resolved, 5);
+    EXPECT_EQ(result.hits, 0b00101u);
+    EXPECT_EQ(result.misses, 0b00010u);
+    EXPECT_EQ(result.headKills, 0b00100u);
+    EXPECT_EQ(result.destroyedPlanes, 0b10u);
+    EXPECT_EQ(b.getJournalSize(), 5);
+}
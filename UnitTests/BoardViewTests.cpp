@@ -0,0 +1,72 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "Board.h"
+#include "BitBoard.h"
+#include "DynamicBoard.h"
+#include "BoardView.h"
+#include "Ship.h"
+#include "Position.h"
+#include "CellState.h"
+#include "Orientation.h"
+
+namespace {
+    void ExpectViewMatchesBoard(const IBoard& board)
+    {
+        const BoardView view = board.getView();
+        ASSERT_EQ(view.size, board.getSize());
+        for (int y = 0; y < view.size; ++y)
+            for (int x = 0; x < view.size; ++x)
+            {
+                const Cell info = board.getCellInfo(Position(x, y));
+                const int cell = y * view.size + x;
+                EXPECT_EQ(view.stateAt(x, y), info.state);
+                EXPECT_EQ(view.isHead(x, y), info.isHead);
+                EXPECT_EQ(BoardView::test(view.hits, cell), info.state == CellState::Hit);
+                EXPECT_EQ(BoardView::test(view.misses, cell), info.state == CellState::Miss);
+                EXPECT_EQ(BoardView::test(view.ships, cell), info.state == CellState::Ship || info.state == CellState::Hit);
+            }
+    }
+
+    void PlayOut(IBoard& board)
+    {
+        ASSERT_TRUE(board.placeShip(Ship(Position(4, 2), Orientation::Up)));
+        ASSERT_TRUE(board.placeShip(Ship(Position(7, 7), Orientation::Right)));
+        board.receiveShot(Position(4, 3));
+        board.receiveShot(Position(0, 0));
+        board.receiveShot(Position(4, 2));
+        const Position batch[] = { Position(7, 7), Position(9, 9), Position(6, 6) };
+        board.receiveShots(batch);
+    }
+}
+
+TEST(BoardViewTests, BoardViewMatchesCellInfo)
+{
+    Board b;
+    PlayOut(b);
+    ExpectViewMatchesBoard(b);
+}
+
+TEST(BoardViewTests, BitBoardViewMatchesCellInfo)
+{
+    BitBoard b;
+    PlayOut(b);
+    ExpectViewMatchesBoard(b);
+}
+
+TEST(BoardViewTests, DynamicBoardViewMatchesCellInfo)
+{
+    DynamicBoard b(16);
+    PlayOut(b);
+    ExpectViewMatchesBoard(b);
+}
+
+TEST(BoardViewTests, ViewFollowsLaterShots)
+{
+    Board b;
+    const BoardView view = b.getView();
+    EXPECT_EQ(view.stateAt(5, 5), CellState::Empty);
+    b.receiveShot(Position(5, 5));
+    EXPECT_EQ(view.stateAt(5, 5), CellState::Miss);
+    b.resetBoard();
+    EXPECT_EQ(view.stateAt(5, 5), CellState::Empty);
+}
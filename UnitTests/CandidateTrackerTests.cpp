@@ -0,0 +1,126 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "CandidateTracker.h"
+#include "GameFactory.h"
+#include "PlacementTable.h"
+#include "SplitMix64.h"
+
+namespace {
+    // Counts rebuilt from scratch over the surviving placements.
+    std::vector<std::uint32_t> Recount(const CandidateTracker& tracker)
+    {
+        const int size = tracker.getBoardSize();
+        std::vector<std::uint32_t> counts(static_cast<std::size_t>(size) * size, 0);
+        for (int id = 0; id < tracker.getPlacementCount(); ++id) {
+            if (!tracker.isCandidate(id))
+                continue;
+            Position head = tracker.getHead(id);
+            int o = static_cast<int>(tracker.getOrientation(id));
+            for (const auto& offset : PlacementTable::OFFSETS[o])
+                ++counts[(head.m_y + offset.y) * size + head.m_x + offset.x];
+        }
+        return counts;
+    }
+
+    struct ShotRecorder : IGameListener {
+        void onShipPlaced(const Ship&) override {}
+        void onShotFired(const Cell& cell, GameState) override { shots.push_back(cell); }
+        void onGameStateChanged(GameState) override {}
+        std::vector<Cell> shots;
+    };
+}
+
+TEST(CandidateTrackerTests, StartsWithEveryPlacement)
+{
+    CandidateTracker tracker;
+    EXPECT_EQ(tracker.getPlacementCount(), PlacementTable::COUNT);
+    EXPECT_EQ(tracker.getCandidateCount(), PlacementTable::COUNT);
+
+    std::uint32_t heads = 0;
+    for (auto count : tracker.getHeadCounts())
+        heads += count;
+    EXPECT_EQ(heads, static_cast<std::uint32_t>(PlacementTable::COUNT));
+    EXPECT_EQ(tracker.getCounts(), Recount(tracker));
+}
+
+TEST(CandidateTrackerTests, CellsMatchThePlacementTable)
+{
+    CandidateTracker tracker;
+    for (int id = 0; id < tracker.getPlacementCount(); ++id) {
+        const auto cells = tracker.getCells(id);
+        const auto& expected = PlacementTable::PLACEMENTS[id].cells;
+        ASSERT_EQ(cells.size(), expected.size());
+        EXPECT_TRUE(std::equal(cells.begin(), cells.end(), expected.begin()));
+        EXPECT_EQ(cells[0], PlacementTable::PLACEMENTS[id].head);
+    }
+}
+
+TEST(CandidateTrackerTests, MissDropsEveryPlacementOnTheCell)
+{
+    CandidateTracker tracker;
+    tracker.record(4, 4, false, false);
+    EXPECT_EQ(tracker.getCounts()[4 * 10 + 4], 0u);
+    EXPECT_LT(tracker.getCandidateCount(), PlacementTable::COUNT);
+    EXPECT_EQ(tracker.getCounts(), Recount(tracker));
+}
+
+TEST(CandidateTrackerTests, HitsKeepOnlyPlacementsThatAgreeOnTheHead)
+{
+    CandidateTracker tracker;
+    tracker.record(4, 2, true, true);
+    tracker.record(4, 3, true, false);
+
+    // (4,2) is a head and (4,3) is not, on whichever plane covers them
+    EXPECT_GT(tracker.getHeadCounts()[2 * 10 + 4], 0u);
+    EXPECT_EQ(tracker.getCounts()[2 * 10 + 4], tracker.getHeadCounts()[2 * 10 + 4]);
+    EXPECT_EQ(tracker.getHeadCounts()[3 * 10 + 4], 0u);
+    EXPECT_GT(tracker.getCounts()[3 * 10 + 4], 0u);
+    EXPECT_EQ(tracker.getCounts(), Recount(tracker));
+}
+
+TEST(CandidateTrackerTests, IncrementalCountsMatchARecount)
+{
+    SplitMix64 rng{ 5 };
+    CandidateTracker tracker(14);
+    for (int shot = 0; shot < 60; ++shot) {
+        tracker.record(rng.nextInt(14), rng.nextInt(14), rng.nextInt(3) == 0, rng.nextInt(8) == 0);
+        ASSERT_EQ(tracker.getCounts(), Recount(tracker));
+    }
+
+    tracker.reset(14);
+    EXPECT_EQ(tracker.getCandidateCount(), tracker.getPlacementCount());
+    EXPECT_EQ(tracker.getCounts(), Recount(tracker));
+}
+
+TEST(CandidateTrackerTests, FollowsOnlyTheShootersShots)
+{
+    GameFactory factory("A", "B", 10, 1);
+    std::unique_ptr<IGame> game = factory.create();
+    auto tracker = std::make_shared<CandidateTracker>();
+    auto recorder = std::make_shared<ShotRecorder>();
+    tracker->follow(*game, game->getPlayer1());
+    game->addListener(tracker);
+    game->addListener(recorder);
+
+    game->startGame();
+    ASSERT_TRUE(game->placeShip(Position(4, 2), 1, Orientation::Up));
+    game->switchTurn();
+    ASSERT_TRUE(game->placeShip(Position(5, 6), 1, Orientation::Down));
+    game->switchTurn();
+    ASSERT_EQ(game->getState(), GameState::InProgress);
+
+    game->shoot(Position(3, 3));
+    game->shoot(Position(4, 3));
+    ASSERT_EQ(recorder->shots.size(), 2u);
+
+    CandidateTracker expected;
+    const Cell& own = recorder->shots[0];
+    expected.record(own.position.m_x, own.position.m_y, own.state == CellState::Hit, own.isHead);
+    EXPECT_EQ(tracker->getCandidateCount(), expected.getCandidateCount());
+    EXPECT_EQ(tracker->getCounts(), expected.getCounts());
+
+    // a new game starts from every placement again
+    game->startGame();
+    EXPECT_EQ(tracker->getCandidateCount(), PlacementTable::COUNT);
+}
@@ -0,0 +1,103 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "DynamicBoard.h"
+#include "GameFactory.h"
+#include "Ship.h"
+#include "Position.h"
+#include "CellState.h"
+#include "Orientation.h"
+
+TEST(DynamicBoardTests, PlaceAndShootOnLargeBoard)
+{
+    DynamicBoard b(24);
+    EXPECT_EQ(b.getSize(), 24);
+
+    Ship s(Position(20, 18), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+    EXPECT_FALSE(b.placeShip(Ship(Position(20, 19), Orientation::Left)));
+    EXPECT_FALSE(b.placeShip(Ship(Position(23, 23), Orientation::Up)));
+
+    Position body = s.getParts()[7].getPosition();
+    EXPECT_TRUE(b.receiveShot(body));
+    EXPECT_EQ(b.getCellState(body), CellState::Hit);
+    EXPECT_FALSE(b.receiveShot(body));
+    EXPECT_FALSE(b.receiveShot(Position(0, 0)));
+    EXPECT_EQ(b.getCellState(Position(0, 0)), CellState::Miss);
+    EXPECT_FALSE(b.receiveShot(Position(24, 0)));
+}
+
+TEST(DynamicBoardTests, SunkCountTracksHeadKills)
+{
+    DynamicBoard b(16);
+    Ship first(Position(2, 0), Orientation::Up);
+    Ship second(Position(12, 12), Orientation::Down);
+    ASSERT_TRUE(b.placeShip(first));
+    ASSERT_TRUE(b.placeShip(second));
+
+    b.receiveShot(first.getHead());
+    EXPECT_FALSE(b.allShipsSunk());
+    EXPECT_TRUE(b.getCellInfo(first.getHead()).isHead);
+
+    b.receiveShot(second.getHead());
+    EXPECT_TRUE(b.allShipsSunk());
+
+    b.resetBoard();
+    EXPECT_EQ(b.getShipsCount(), 0);
+    EXPECT_EQ(b.getCellState(first.getHead()), CellState::Empty);
+}
+
+TEST(DynamicBoardTests, FactoryBuildsConfiguredArena)
+{
+    GameFactory factory("A", "B", 32, 6);
+    auto game = factory.create();
+
+    EXPECT_EQ(game->getGridSize(), 32);
+    EXPECT_EQ(game->getMaxShips(), 6);
+
+    GameFactory classic;
+    EXPECT_EQ(classic.create()->getGridSize(), 10);
+}
+
+TEST(DynamicBoardTests, FactoryKeepsBoardSizeInRange)
+{
+    // 0, negative, size * size past int, and sizes a byte cannot hold
+    for (int size : { 0, -7, 3, 50000 }) {
+        GameFactory factory("A", "B", size, 1);
+        const int built = factory.create()->getGridSize();
+        EXPECT_GE(built, GameFactory::MIN_BOARD_SIZE);
+        EXPECT_LE(built, GameFactory::MAX_BOARD_SIZE);
+    }
+    EXPECT_EQ(GameFactory("A", "B", 300, 1).create()->getGridSize(), GameFactory::MAX_BOARD_SIZE);
+}
+
+TEST(DynamicBoardTests, ReceiveShotsReportsBatch)
+{
+    DynamicBoard b(16);
+    Ship s(Position(8, 8), Orientation::Right);
+    ASSERT_TRUE(b.placeShip(s));
+
+    const Position shots[] = { s.getParts()[1].getPosition(), Position(15, 15), s.getHead() };
+    auto result = b.receiveShots(shots);
+
+    EXPECT_EQ(result.hits, 0b101u);
+    EXPECT_EQ(result.misses, 0b010u);
+    EXPECT_EQ(result.headKills, 0b100u);
+    EXPECT_EQ(result.destroyedPlanes, 0b1u);
+    EXPECT_TRUE(b.allShipsSunk());
+}
+
+TEST(DynamicBoardTests, PlanesPastTheBatchMaskStillGoDown)
+{
+    // planes fill 5x4 boxes, 8 to a row
+    DynamicBoard b(40);
+    const int planes = ShotBatchResult::MAX_PLANES + 1;
+    for (int p = 0; p < planes; ++p)
+        ASSERT_TRUE(b.placeShip(Ship(Position(2 + 5 * (p % 8), 4 * (p / 8)), Orientation::Up)));
+
+    const Position shots[] = { b.getShips()[planes - 2].getHead(), b.getShips()[planes - 1].getHead() };
+    auto result = b.receiveShots(shots);
+
+    EXPECT_EQ(result.headKills, 0b11u);
+    EXPECT_EQ(result.destroyedPlanes, std::uint64_t{ 1 } << (planes - 2));
+    EXPECT_TRUE(b.getShips()[planes - 1].isSunk());
+}
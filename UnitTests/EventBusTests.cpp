@@ -0,0 +1,113 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "EventBus.h"
+#include "GameFactory.h"
+
+namespace {
+    GameEvent Shot(int x, int y, bool hit)
+    {
+        GameEvent event;
+        event.type = GameEventType::ShotFired;
+        event.x = static_cast<std::int16_t>(x);
+        event.y = static_cast<std::int16_t>(y);
+        event.cellState = hit ? CellState::Hit : CellState::Miss;
+        event.state = GameState::SwitchingTurn;
+        return event;
+    }
+}
+
+TEST(EventBusTests, CapacityIsRoundedToPowerOfTwo)
+{
+    EventBus bus(100);
+    EXPECT_EQ(bus.getCapacity(), 128u);
+}
+
+TEST(EventBusTests, DrainDeliversInOrderAndFilters)
+{
+    EventBus bus(16);
+    EventCursor shots = bus.subscribe(eventMask(GameEventType::ShotFired));
+    EventCursor all = bus.subscribe();
+
+    GameEvent state;
+    state.type = GameEventType::StateChanged;
+    state.state = GameState::InProgress;
+    bus.publish(state);
+    bus.publish(Shot(1, 2, true));
+    bus.publish(Shot(3, 4, false));
+
+    std::vector<GameEvent> seen;
+    EXPECT_EQ(bus.drain(shots, [&](const GameEvent& e) { seen.push_back(e); }), 2u);
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[0].x, 1);
+    EXPECT_EQ(seen[0].sequence, 1u);
+    EXPECT_EQ(seen[1].cellState, CellState::Miss);
+    EXPECT_EQ(bus.pending(shots), 0u);
+
+    EXPECT_EQ(bus.pending(all), 3u);
+    EXPECT_EQ(bus.drain(all, [](const GameEvent&) {}, 2), 2u);
+    EXPECT_EQ(bus.pending(all), 1u);
+}
+
+TEST(EventBusTests, SlowSubscriberCountsDroppedEvents)
+{
+    EventBus bus(4);
+    EventCursor cursor = bus.subscribe();
+    for (int i = 0; i < 10; ++i)
+        bus.publish(Shot(i, 0, false));
+
+    std::vector<int> xs;
+    bus.drain(cursor, [&](const GameEvent& e) { xs.push_back(e.x); });
+    EXPECT_EQ(cursor.dropped, 6u);
+    EXPECT_EQ(xs, (std::vector<int>{ 6, 7, 8, 9 }));
+}
+
+TEST(EventBusTests, TotalsSummariseWithoutDraining)
+{
+    EventBus bus(2);
+    bus.publish(Shot(0, 0, true));
+    bus.publish(Shot(1, 0, false));
+    GameEvent head = Shot(2, 0, true);
+    head.isHead = true;
+    head.state = GameState::GameOver;
+    bus.publish(head);
+
+    const EventTotals& totals = bus.getTotals();
+    EXPECT_EQ(totals.shots, 3u);
+    EXPECT_EQ(totals.hits, 2u);
+    EXPECT_EQ(totals.headHits, 1u);
+    EXPECT_EQ(totals.lastState, GameState::GameOver);
+}
+
+TEST(EventBusTests, GamePublishesEvents)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 1);
+    auto game = factory.create();
+    EventCursor cursor = game->getEventBus().subscribe();
+
+    game->startGame();
+    ASSERT_TRUE(game->placeShip(Position(4, 2), 10, Orientation::Up));
+    game->switchTurn();
+    ASSERT_TRUE(game->placeShip(Position(5, 6), 10, Orientation::Down));
+    game->switchTurn();
+    game->shoot(Position(5, 6));
+
+    std::vector<GameEvent> events;
+    game->getEventBus().drain(cursor, [&](const GameEvent& e) { events.push_back(e); });
+
+    ASSERT_EQ(events.size(), 8u);
+    EXPECT_EQ(events[0].type, GameEventType::StateChanged);
+    EXPECT_EQ(events[1].type, GameEventType::ShipPlaced);
+    EXPECT_EQ(events[2].type, GameEventType::TurnSwitched);
+    EXPECT_EQ(events[2].player, 1);
+    EXPECT_EQ(events[3].type, GameEventType::ShipPlaced);
+    EXPECT_EQ(events[3].player, 1);
+    EXPECT_EQ(events[3].orientation, Orientation::Down);
+    EXPECT_EQ(events[4].type, GameEventType::TurnSwitched);
+    EXPECT_EQ(events[4].turnNumber, 2u);
+    EXPECT_EQ(events[5].state, GameState::InProgress);
+    EXPECT_EQ(events[6].type, GameEventType::ShotFired);
+    EXPECT_EQ(events[6].player, 0);
+    EXPECT_TRUE(events[6].isHead);
+    EXPECT_EQ(events[7].state, GameState::GameOver);
+}
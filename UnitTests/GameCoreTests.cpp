@@ -0,0 +1,95 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "GameCore.h"
+#include "Board.h"
+#include "BitBoard.h"
+#include "DynamicBoard.h"
+#include "GameFactory.h"
+#include "IGameListener.h"
+
+namespace {
+    template <typename BoardT>
+    void PlaceOnePlaneEach(GameCore<BoardT>& core)
+    {
+        core.start();
+        ASSERT_TRUE(core.placeShip(Ship(Position(4, 2), Orientation::Up)));
+        EXPECT_FALSE(core.switchTurn());
+        ASSERT_TRUE(core.placeShip(Ship(Position(5, 6), Orientation::Down)));
+        EXPECT_TRUE(core.switchTurn());
+        EXPECT_EQ(core.getState(), GameState::InProgress);
+        EXPECT_EQ(core.getTurn(), 0);
+    }
+
+    struct ShotRecorder : IGameListener {
+        void onShipPlaced(const Ship&) override {}
+        void onShotFired(const Cell& cell, GameState) override { last = cell; }
+        void onGameStateChanged(GameState) override {}
+        Cell last{};
+    };
+}
+
+TEST(GameCoreTests, ShotsAlternateTurns)
+{
+    GameCore<Board> core(1);
+    PlaceOnePlaneEach(core);
+
+    auto miss = core.shoot(Position(0, 0));
+    EXPECT_TRUE(miss.resolved);
+    EXPECT_FALSE(miss.hit);
+    EXPECT_EQ(core.getTurn(), 1);
+    EXPECT_EQ(core.getBoard(1).getCellState(Position(0, 0)), CellState::Miss);
+
+    auto hit = core.shoot(Position(4, 3));
+    EXPECT_TRUE(hit.hit);
+    EXPECT_FALSE(hit.headHit);
+    EXPECT_EQ(core.getTurn(), 0);
+}
+
+TEST(GameCoreTests, HeadHitEndsGame)
+{
+    GameCore<BitBoard> core(1);
+    PlaceOnePlaneEach(core);
+
+    auto result = core.shoot(Position(5, 6));
+    EXPECT_TRUE(result.headHit);
+    EXPECT_TRUE(result.gameOver);
+    EXPECT_EQ(core.getState(), GameState::GameOver);
+    EXPECT_TRUE(core.isGameOver());
+    EXPECT_FALSE(core.shoot(Position(0, 0)).resolved);
+}
+
+TEST(GameCoreTests, WorksOnDynamicBoards)
+{
+    GameCore<DynamicBoard> core(1, 14);
+    PlaceOnePlaneEach(core);
+    EXPECT_EQ(core.getBoard(0).getSize(), 14);
+    EXPECT_TRUE(core.shoot(Position(5, 6)).gameOver);
+}
+
+TEST(GameCoreTests, RejectsOverlappingPlanes)
+{
+    GameCore<Board> core(2);
+    core.start();
+    ASSERT_TRUE(core.placeShip(Ship(Position(4, 2), Orientation::Up)));
+    EXPECT_FALSE(core.placeShip(Ship(Position(4, 3), Orientation::Up)));
+    EXPECT_EQ(core.getBoard(0).getShipsCount(), 1);
+}
+
+TEST(GameCoreTests, GameReportsHeadHits)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 1);
+    auto game = factory.create();
+    auto recorder = std::make_shared<ShotRecorder>();
+    game->addListener(recorder);
+
+    game->startGame();
+    ASSERT_TRUE(game->placeShip(Position(4, 2), 10, Orientation::Up));
+    game->switchTurn();
+    ASSERT_TRUE(game->placeShip(Position(5, 6), 10, Orientation::Down));
+    game->switchTurn();
+
+    game->shoot(Position(5, 6));
+    EXPECT_EQ(recorder->last.state, CellState::Hit);
+    EXPECT_TRUE(recorder->last.isHead);
+    EXPECT_EQ(game->getState(), GameState::GameOver);
+}
@@ -0,0 +1,171 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include "GameSnapshot.h"
+#include "Board.h"
+#include "BitBoard.h"
+#include "Game.h"
+#include "GameFactory.h"
+#include "IGameListener.h"
+
+namespace {
+    template <typename BoardT>
+    void PlayOn(BoardT& board)
+    {
+        ASSERT_TRUE(board.placeShip(Ship(Position(4, 2), Orientation::Up)));
+        ASSERT_TRUE(board.placeShip(Ship(Position(2, 6), Orientation::Up)));
+        board.receiveShot(Position(0, 0));
+        board.receiveShot(Position(4, 3));
+        board.receiveShot(Position(2, 6));
+        board.receiveShot(Position(9, 9));
+    }
+
+    template <typename BoardT>
+    void ExpectSameCells(const BoardT& a, const IBoard& b)
+    {
+        for (int y = 0; y < 10; ++y)
+            for (int x = 0; x < 10; ++x) {
+                EXPECT_EQ(a.getCellState(Position(x, y)), b.getCellState(Position(x, y)));
+                EXPECT_EQ(a.getCellInfo(Position(x, y)).isHead, b.getCellInfo(Position(x, y)).isHead);
+            }
+    }
+
+    struct CountingListener : IGameListener {
+        void onShipPlaced(const Ship&) override { ++calls; }
+        void onShotFired(const Cell&, GameState) override { ++calls; }
+        void onGameStateChanged(GameState) override { ++calls; }
+        int calls{ 0 };
+    };
+}
+
+TEST(GameSnapshotTests, SnapshotIsSmallAndTriviallyCopyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable_v<GameSnapshot>);
+    EXPECT_LE(sizeof(GameSnapshot), 128u);
+}
+
+TEST(GameSnapshotTests, BoardRoundTrip)
+{
+    Board board;
+    PlayOn(board);
+
+    BoardSnapshot snapshot;
+    ASSERT_TRUE(board.saveSnapshot(snapshot));
+    EXPECT_EQ(snapshot.planeCount, 2);
+
+    Board restored;
+    ASSERT_TRUE(restored.loadSnapshot(snapshot));
+    ExpectSameCells(board, restored);
+    EXPECT_EQ(restored.getObservationHash(), board.getObservationHash());
+    EXPECT_EQ(restored.getLayoutHash(), board.getLayoutHash());
+    EXPECT_EQ(restored.getJournalSize(), 0);
+    ASSERT_EQ(restored.getShipsCount(), 2);
+    EXPECT_EQ(restored.getShips()[0].getHitMask(), board.getShips()[0].getHitMask());
+    EXPECT_TRUE(restored.getShips()[1].isSunk());
+    EXPECT_FALSE(restored.allShipsSunk());
+}
+
+TEST(GameSnapshotTests, BoardTypesShareTheFormat)
+{
+    BitBoard bitBoard;
+    PlayOn(bitBoard);
+
+    BoardSnapshot snapshot;
+    ASSERT_TRUE(bitBoard.saveSnapshot(snapshot));
+
+    Board board;
+    ASSERT_TRUE(board.loadSnapshot(snapshot));
+    ExpectSameCells(bitBoard, board);
+
+    BitBoard back;
+    ASSERT_TRUE(back.loadSnapshot(snapshot));
+    ExpectSameCells(back, board);
+}
+
+TEST(GameSnapshotTests, RejectsInconsistentSnapshot)
+{
+    Board board;
+    PlayOn(board);
+    BoardSnapshot good;
+    ASSERT_TRUE(board.saveSnapshot(good));
+
+    BoardSnapshot overlap = good;
+    overlap.placements[1] = overlap.placements[0];
+    EXPECT_FALSE(board.loadSnapshot(overlap));
+
+    BoardSnapshot missOnPlane = good;
+    missOnPlane.misses.set(4 + 2 * 10);
+    EXPECT_FALSE(board.loadSnapshot(missOnPlane));
+
+    BoardSnapshot badId = good;
+    badId.placements[0] = 0xFF;
+    EXPECT_FALSE(board.loadSnapshot(badId));
+
+    // a rejected snapshot leaves the board alone
+    EXPECT_EQ(board.getCellState(Position(4, 3)), CellState::Hit);
+    EXPECT_EQ(board.getShipsCount(), 2);
+}
+
+TEST(GameSnapshotTests, FactoryClonesGame)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 2);
+    auto game = factory.create();
+    game->startGame();
+    ASSERT_TRUE(game->placeShip(Position(4, 2), 10, Orientation::Up));
+    ASSERT_TRUE(game->placeShip(Position(2, 6), 10, Orientation::Up));
+    game->switchTurn();
+    ASSERT_TRUE(game->placeShip(Position(5, 6), 10, Orientation::Down));
+    ASSERT_TRUE(game->placeShip(Position(7, 1), 10, Orientation::Up));
+    game->switchTurn();
+    game->shoot(Position(5, 6));
+    game->shoot(Position(4, 3));
+
+    GameSnapshot snapshot;
+    ASSERT_TRUE(game->saveSnapshot(snapshot));
+
+    // snapshots are plain bytes
+    GameSnapshot copy;
+    std::memcpy(&copy, &snapshot, sizeof(copy));
+
+    auto clone = factory.create(copy);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_EQ(clone->getState(), game->getState());
+    EXPECT_EQ(clone->getCurrentPlayer().lock(), clone->getPlayer1());
+    ExpectSameCells(*game->getPlayer1()->getBoard(), *clone->getPlayer1()->getBoard());
+    ExpectSameCells(*game->getPlayer2()->getBoard(), *clone->getPlayer2()->getBoard());
+
+    // the clone plays on independently
+    clone->shoot(Position(7, 1));
+    EXPECT_EQ(clone->getState(), GameState::GameOver);
+    EXPECT_EQ(game->getState(), GameState::SwitchingTurn);
+    EXPECT_EQ(game->getPlayer2()->getBoard()->getCellState(Position(7, 1)), CellState::Ship);
+}
+
+TEST(GameSnapshotTests, LoadingDoesNotNotify)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 1);
+    auto game = factory.create();
+    auto listener = std::make_shared<CountingListener>();
+    game->addListener(listener);
+
+    GameSnapshot snapshot;
+    snapshot.state = GameState::InProgress;
+    snapshot.maxShips = 1;
+    snapshot.boards[0].planeCount = 1;
+    snapshot.boards[1].planeCount = 1;
+    snapshot.boards[1].placements[0] = static_cast<std::uint8_t>(PlacementTable::find(5, 6, Orientation::Down) - PlacementTable::PLACEMENTS.data());
+    ASSERT_TRUE(game->loadSnapshot(snapshot));
+    EXPECT_EQ(listener->calls, 0);
+    EXPECT_EQ(game->getPlayer2()->getBoard()->getCellState(Position(5, 6)), CellState::Ship);
+}
+
+TEST(GameSnapshotTests, LargeBoardsHaveNoSnapshot)
+{
+    GameFactory factory("A", "B", 14, 2);
+    auto game = factory.create();
+    game->startGame();
+
+    GameSnapshot snapshot;
+    EXPECT_FALSE(game->saveSnapshot(snapshot));
+    EXPECT_EQ(factory.create(snapshot), nullptr);
+}
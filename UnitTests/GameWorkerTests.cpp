@@ -0,0 +1,227 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "GameWorker.h"
+#include "GameFactory.h"
+#include "RandomStrategies.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+namespace {
+    // Polls the worker like the UI timer would, until pred(frame) holds or two seconds pass.
+    template <typename Pred>
+    bool PumpUntil(GameWorker& worker, std::vector<WorkerMessage>& messages, Pred pred)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (std::chrono::steady_clock::now() < deadline) {
+            worker.drainMessages([&](const WorkerMessage& m) { messages.push_back(m); });
+            worker.updateFrame();
+            if (pred(worker.getFrame()))
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    // Places one plane, then gives up as if the board had no room left.
+    class GivesUpPlacement : public IPlacementStrategy {
+    public:
+        bool placeShips(int, int, const std::function<bool(const Ship&)>& tryPlace, SplitMix64&) override
+        {
+            tryPlace(Ship(Position(2, 0), Orientation::Up));
+            return false;
+        }
+    };
+}
+
+TEST(SpscQueueTests, KeepsOrderAndReportsFull)
+{
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(queue.full());
+    EXPECT_TRUE(queue.tryPush(4));
+
+    std::vector<int> rest;
+    queue.drain([&](int v) { rest.push_back(v); });
+    EXPECT_EQ(rest, (std::vector<int>{ 1, 2, 3, 4 }));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTests, HandsOverAcrossThreads)
+{
+    SpscQueue<int, 64> queue;
+    constexpr int COUNT = 100000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < COUNT; ++i)
+            while (!queue.tryPush(i)) {}
+    });
+
+    int expected = 0;
+    while (expected < COUNT) {
+        int value;
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+}
+
+TEST(TripleBufferTests, ReaderSeesLatestValue)
+{
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.update());
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.front(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.front(), 2);
+}
+
+TEST(GameWorkerTests, CommandsReachGameAndFramesFollow)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 1);
+    GameWorker worker(factory.create());
+    worker.start();
+
+    worker.post({ GameCommandType::Start });
+    worker.post({ GameCommandType::PlaceShip, 4, 2, Orientation::Up });
+    worker.post({ GameCommandType::PlaceShip, 4, 3, Orientation::Up });    // overlaps, rejected
+    worker.post({ GameCommandType::SwitchTurn });
+    worker.post({ GameCommandType::PlaceShip, 5, 6, Orientation::Down });
+    worker.post({ GameCommandType::SwitchTurn });
+    worker.post({ GameCommandType::Shoot, 5, 5 });
+
+    std::vector<WorkerMessage> messages;
+    ASSERT_TRUE(PumpUntil(worker, messages, [](const GameFrame& f) { return f.boards[1].states.size() == 100
+        && f.boards[1].view().stateAt(5, 5) == CellState::Hit; }));
+
+    const GameFrame& frame = worker.getFrame();
+    EXPECT_EQ(frame.turn, 1);
+    EXPECT_EQ(frame.boards[0].shipCount, 1);
+    EXPECT_TRUE(frame.boards[0].view().isHead(4, 2));
+
+    PumpUntil(worker, messages, [&](const GameFrame&) { return messages.size() >= 8; });
+    int rejected = 0;
+    int shots = 0;
+    for (const auto& m : messages) {
+        if (m.kind == WorkerMessage::Kind::PlacementRejected)
+            ++rejected;
+        else if (m.event.type == GameEventType::ShotFired)
+            ++shots;
+    }
+    EXPECT_EQ(rejected, 1);
+    EXPECT_EQ(shots, 1);
+}
+
+TEST(GameWorkerTests, RejectionsWaitForRoomInsteadOfBeingDropped)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 1);
+    GameWorker worker(factory.create());
+    worker.start();
+    worker.post({ GameCommandType::Start });
+
+    // more refusals than the message queue holds, with nobody draining yet
+    const int total = static_cast<int>(GameWorker::MESSAGE_CAPACITY + GameWorker::COMMAND_CAPACITY / 2);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    for (int posted = 0; posted < total && std::chrono::steady_clock::now() < deadline;) {
+        if (worker.post({ GameCommandType::PlaceShip, -5, -5, Orientation::Up }))
+            ++posted;
+        else
+            std::this_thread::yield();
+    }
+
+    // give the worker time to run into the full message queue
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::vector<WorkerMessage> messages;
+    auto rejected = [&messages] {
+        int count = 0;
+        for (const auto& m : messages)
+            count += m.kind == WorkerMessage::Kind::PlacementRejected;
+        return count;
+    };
+    EXPECT_TRUE(PumpUntil(worker, messages, [&](const GameFrame&) { return rejected() >= total; }));
+    EXPECT_EQ(rejected(), total);
+}
+
+TEST(GameWorkerTests, BotsPlayWholeGameOnLogicThread)
+{
+    GameFactory factory;
+    GameWorker worker(factory.create());
+    worker.setBot(0, std::make_unique<RandomPlacement>(), std::make_unique<HuntShooter>(), 1);
+    worker.setBot(1, std::make_unique<RandomPlacement>(), std::make_unique<RandomShooter>(), 2);
+    worker.start();
+    worker.post({ GameCommandType::Start });
+
+    std::vector<WorkerMessage> messages;
+    ASSERT_TRUE(PumpUntil(worker, messages, [](const GameFrame& f) { return f.state == GameState::GameOver; }));
+    worker.stop();
+    worker.drainMessages([&](const WorkerMessage& m) { messages.push_back(m); });
+
+    ASSERT_FALSE(messages.empty());
+    EXPECT_EQ(messages.back().event.type, GameEventType::StateChanged);
+    EXPECT_EQ(messages.back().event.state, GameState::GameOver);
+}
+
+TEST(GameWorkerTests, LongBotGameLosesNoEvents)
+{
+    // a 20x20 game publishes more events than the bus holds, so they have to go out between moves
+    GameFactory factory("A", "B", 20, 3);
+    GameWorker worker(factory.create());
+    worker.setBot(0, std::make_unique<RandomPlacement>(), std::make_unique<RandomShooter>(), 3);
+    worker.setBot(1, std::make_unique<RandomPlacement>(), std::make_unique<RandomShooter>(), 4);
+    worker.start();
+    worker.post({ GameCommandType::Start });
+
+    std::vector<WorkerMessage> messages;
+    ASSERT_TRUE(PumpUntil(worker, messages, [](const GameFrame& f) { return f.state == GameState::GameOver; }));
+    worker.stop();
+    worker.drainMessages([&](const WorkerMessage& m) { messages.push_back(m); });
+
+    EXPECT_GT(worker.getFrame().eventCount, EventBus::DEFAULT_CAPACITY);
+    EXPECT_EQ(messages.size(), worker.getFrame().eventCount);
+}
+
+TEST(GameWorkerTests, BotThatCannotPlaceEndsTheMatch)
+{
+    GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, 2);
+    GameWorker worker(factory.create());
+    worker.setBot(0, std::make_unique<GivesUpPlacement>(), std::make_unique<RandomShooter>(), 1);
+    worker.start();
+    worker.post({ GameCommandType::Start });
+
+    std::vector<WorkerMessage> messages;
+    auto aborted = [&messages](const GameFrame&) {
+        return !messages.empty() && messages.back().kind == WorkerMessage::Kind::MatchAborted;
+    };
+    ASSERT_TRUE(PumpUntil(worker, messages, aborted));
+    EXPECT_EQ(messages.back().event.player, 0);
+    EXPECT_EQ(messages.end()[-2].event.type, GameEventType::ShipPlaced);
+
+    // nothing but a new Start is served after that
+    worker.post({ GameCommandType::SwitchTurn });
+    worker.post({ GameCommandType::PlaceShip, 5, 6, Orientation::Down });
+    const std::size_t seen = messages.size();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    worker.drainMessages([&](const WorkerMessage& m) { messages.push_back(m); });
+    worker.updateFrame();
+    EXPECT_EQ(messages.size(), seen);
+    EXPECT_EQ(worker.getFrame().turn, 0);
+    EXPECT_EQ(worker.getFrame().state, GameState::PlacingShips);
+}
@@ -0,0 +1,144 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "BitBoard.h"
+#include "Board.h"
+#include "DynamicBoard.h"
+#include "Ship.h"
+#include "Position.h"
+#include "CellState.h"
+#include "Orientation.h"
+
+// The rules every IBoard implementation has to follow, checked on the classic 10x10 board.
+namespace {
+    template <typename B>
+    B MakeBoard()
+    {
+        return B();
+    }
+
+    template <>
+    DynamicBoard MakeBoard<DynamicBoard>()
+    {
+        return DynamicBoard(10);
+    }
+}
+
+template <typename B>
+class IBoardTests : public ::testing::Test {
+protected:
+    B b = MakeBoard<B>();
+};
+
+using BoardTypes = ::testing::Types<Board, BitBoard, DynamicBoard>;
+TYPED_TEST_SUITE(IBoardTests, BoardTypes);
+
+TYPED_TEST(IBoardTests, DefaultBoardEmpty)
+{
+    auto& b = this->b;
+    EXPECT_EQ(b.getSize(), 10);
+    EXPECT_EQ(b.getShipsCount(), 0);
+    EXPECT_EQ(b.getCellState(Position(0, 0)), CellState::Empty);
+}
+
+TYPED_TEST(IBoardTests, PlaceShipAndCellState)
+{
+    auto& b = this->b;
+    Ship s(Position(3, 3), Orientation::Up);
+    EXPECT_TRUE(b.placeShip(s));
+    EXPECT_EQ(b.getShipsCount(), 1);
+
+    for (const auto& part : s.getParts())
+        EXPECT_EQ(b.getCellState(part.getPosition()), CellState::Ship);
+}
+
+TYPED_TEST(IBoardTests, PreventOverlap)
+{
+    auto& b = this->b;
+    EXPECT_TRUE(b.placeShip(Ship(Position(3, 3), Orientation::Up)));
+    EXPECT_FALSE(b.placeShip(Ship(Position(3, 3), Orientation::Up)));
+    EXPECT_EQ(b.getShipsCount(), 1);
+}
+
+TYPED_TEST(IBoardTests, PlaceShipOutsideFails)
+{
+    auto& b = this->b;
+    EXPECT_FALSE(b.placeShip(Ship(Position(-1, 0), Orientation::Up)));
+    // the body would run off the bottom-right corner
+    EXPECT_FALSE(b.placeShip(Ship(Position(9, 9), Orientation::Up)));
+    EXPECT_EQ(b.getShipsCount(), 0);
+}
+
+TYPED_TEST(IBoardTests, ReceiveShotHitAndMiss)
+{
+    auto& b = this->b;
+    Ship s(Position(4, 4), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+
+    Position body = s.getParts().back().getPosition();
+    EXPECT_TRUE(b.receiveShot(body));
+    EXPECT_EQ(b.getCellState(body), CellState::Hit);
+
+    EXPECT_FALSE(b.receiveShot(Position(0, 0)));
+    EXPECT_EQ(b.getCellState(Position(0, 0)), CellState::Miss);
+}
+
+TYPED_TEST(IBoardTests, ReceiveShotInvalidPositionsReturnFalse)
+{
+    auto& b = this->b;
+    EXPECT_FALSE(b.receiveShot(Position(-1, 0)));
+    EXPECT_FALSE(b.receiveShot(Position(10, 10)));
+}
+
+TYPED_TEST(IBoardTests, RepeatedShotDoesNotChangeState)
+{
+    auto& b = this->b;
+    Ship s(Position(5, 5), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+
+    Position target = s.getParts().back().getPosition();
+    EXPECT_TRUE(b.receiveShot(target));
+    EXPECT_FALSE(b.receiveShot(target));
+    EXPECT_EQ(b.getCellState(target), CellState::Hit);
+}
+
+TYPED_TEST(IBoardTests, AllShipsSunk)
+{
+    auto& b = this->b;
+    Ship s(Position(2, 0), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+
+    for (const auto& part : s.getParts())
+        b.receiveShot(part.getPosition());
+    EXPECT_TRUE(b.allShipsSunk());
+}
+
+TYPED_TEST(IBoardTests, HeadHitSinksPlane)
+{
+    auto& b = this->b;
+    ASSERT_TRUE(b.placeShip(Ship(Position(2, 0), Orientation::Up)));
+    ASSERT_TRUE(b.placeShip(Ship(Position(7, 0), Orientation::Up)));
+
+    EXPECT_TRUE(b.receiveShot(Position(2, 0)));
+    EXPECT_FALSE(b.allShipsSunk());
+    EXPECT_TRUE(b.getShips()[0].isSunk());
+    EXPECT_TRUE(b.getCellInfo(Position(2, 0)).isHead);
+
+    EXPECT_TRUE(b.receiveShot(Position(7, 0)));
+    EXPECT_TRUE(b.allShipsSunk());
+}
+
+TYPED_TEST(IBoardTests, ReceiveShotsReportsBatch)
+{
+    auto& b = this->b;
+    Ship s(Position(4, 4), Orientation::Up);
+    ASSERT_TRUE(b.placeShip(s));
+
+    const Position shots[] = { Position(0, 0), s.getParts()[9].getPosition(), s.getHead(), s.getHead() };
+    auto result = b.receiveShots(shots);
+
+    EXPECT_EQ(result.hits, 0b0110u);
+    EXPECT_EQ(result.misses, 0b0001u);
+    EXPECT_EQ(result.headKills, 0b0100u);
+    EXPECT_EQ(result.destroyedPlanes, 0b1u);
+    EXPECT_TRUE(b.allShipsSunk());
+}
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "LayoutDatabase.h"
+#include "LayoutTestShots.h"
+
+namespace {
+    std::string TempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST(LayoutDatabaseTests, HoldsEveryLayout)
+{
+    const std::string path = TempPath("avioane_layouts_test.bin");
+    ASSERT_TRUE(LayoutDatabase::write(path, 3));
+
+    LayoutDatabase database;
+    ASSERT_TRUE(database.open(path));
+    EXPECT_EQ(database.getPlaneCount(), 3);
+
+    LayoutDensity density;
+    EXPECT_EQ(database.getLayoutCount(), LayoutEnumerator(3).countDensity(LayoutObservation(), density));
+    // one layout per symmetry class
+    EXPECT_LT(database.getStoredCount() * 7, database.getLayoutCount());
+
+    database.close();
+    std::filesystem::remove(path);
+}
+
+TEST(LayoutDatabaseTests, FilterMatchesEnumerator)
+{
+    const std::string path = TempPath("avioane_layouts_filter.bin");
+    ASSERT_TRUE(LayoutDatabase::write(path, 3));
+    LayoutDatabase database;
+    ASSERT_TRUE(database.open(path));
+
+    const LayoutObservation observation = SomeShots();
+    LayoutDensity expected;
+    LayoutDensity actual;
+    const std::uint64_t count = LayoutEnumerator(3).countDensity(observation, expected);
+    EXPECT_EQ(database.countDensity(observation, actual), count);
+    EXPECT_EQ(actual.occupied, expected.occupied);
+    EXPECT_EQ(actual.heads, expected.heads);
+
+    std::vector<std::uint32_t> matches;
+    EXPECT_EQ(database.filter(observation, matches), count);
+    for (std::uint32_t match : matches) {
+        std::uint8_t ids[3];
+        database.getLayout(match, ids);
+        BitMask128 occupied;
+        for (int i = 0; i < 3; ++i)
+            occupied |= PlacementTable::PLACEMENTS[ids[i]].mask;
+        EXPECT_EQ(occupied & observation.hits, observation.hits);
+        EXPECT_TRUE((occupied & observation.misses).none());
+    }
+
+    database.close();
+    std::filesystem::remove(path);
+}
+
+TEST(LayoutDatabaseTests, RejectsBadFiles)
+{
+    LayoutDatabase database;
+    EXPECT_FALSE(database.open(TempPath("avioane_layouts_missing.bin")));
+
+    const std::string path = TempPath("avioane_layouts_bad.bin");
+    ASSERT_TRUE(LayoutDatabase::write(path, 1));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(database.open(path));
+    EXPECT_FALSE(database.isOpen());
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a layout database, just some text that is long enough for a header..........";
+    }
+    EXPECT_FALSE(database.open(path));
+    std::filesystem::remove(path);
+}
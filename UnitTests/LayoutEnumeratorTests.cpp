@@ -0,0 +1,158 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "LayoutEnumerator.h"
+#include "Board.h"
+#include "DensityShooter.h"
+#include "RandomStrategies.h"
+#include "Simulation.h"
+#include "LayoutTestShots.h"
+
+namespace {
+    std::uint64_t CountTriplesByHand()
+    {
+        std::uint64_t count = 0;
+        const auto& placements = PlacementTable::PLACEMENTS;
+        for (int a = 0; a < PlacementTable::COUNT; ++a)
+            for (int b = a + 1; b < PlacementTable::COUNT; ++b) {
+                if ((placements[a].mask & placements[b].mask).any())
+                    continue;
+                for (int c = b + 1; c < PlacementTable::COUNT; ++c)
+                    if ((placements[c].mask & (placements[a].mask | placements[b].mask)).none())
+                        ++count;
+            }
+        return count;
+    }
+}
+
+TEST(LayoutEnumeratorTests, OpeningCountMatchesBruteForce)
+{
+    LayoutEnumerator enumerator(3);
+    LayoutDensity density;
+    EXPECT_EQ(enumerator.countDensity(LayoutObservation(), density), CountTriplesByHand());
+    EXPECT_EQ(density.layouts, CountTriplesByHand());
+}
+
+TEST(LayoutEnumeratorTests, DensityMatchesListedLayouts)
+{
+    LayoutEnumerator enumerator(3);
+    const LayoutObservation observation = SomeShots();
+
+    LayoutDensity listed;
+    std::uint64_t count = enumerator.forEachLayout(observation, [&listed, &observation](const std::uint16_t* ids, int planes) {
+        ASSERT_EQ(planes, 3);
+        ++listed.layouts;
+        for (int i = 0; i < planes; ++i) {
+            const auto& placement = PlacementTable::PLACEMENTS[ids[i]];
+            if (!observation.heads.test(placement.head)) {
+                for (int cell : placement.cells)
+                    ++listed.occupied[cell];
+            }
+            ++listed.heads[placement.head];
+        }
+    });
+
+    LayoutDensity counted;
+    EXPECT_EQ(enumerator.countDensity(observation, counted), count);
+    EXPECT_GT(count, 0u);
+    EXPECT_EQ(counted.layouts, listed.layouts);
+    EXPECT_EQ(counted.occupied, listed.occupied);
+    EXPECT_EQ(counted.heads, listed.heads);
+}
+
+TEST(LayoutEnumeratorTests, LayoutsAgreeWithObservation)
+{
+    LayoutEnumerator enumerator(3);
+    const LayoutObservation observation = SomeShots();
+    LayoutDensity density;
+    std::uint64_t count = enumerator.countDensity(observation, density);
+
+    // every layout has the head where one was seen, and no miss; the plane with the hit head is
+    // destroyed, so (4,3) only counts where another plane covers it
+    EXPECT_EQ(density.heads[4 + 2 * 10], count);
+    EXPECT_EQ(density.occupied[4 + 2 * 10], 0u);
+    EXPECT_LT(density.occupied[4 + 3 * 10], count);
+    EXPECT_EQ(density.heads[4 + 3 * 10], 0u);
+    EXPECT_EQ(density.occupied[0], 0u);
+    EXPECT_EQ(density.occupied[7 + 7 * 10], 0u);
+    EXPECT_LT(density.occupied[2 + 3 * 10], count);
+}
+
+TEST(LayoutEnumeratorTests, ImpossibleObservationHasNoLayouts)
+{
+    LayoutEnumerator enumerator(1);
+    LayoutObservation observation;
+    observation.record(0, true, false);
+    observation.record(99, true, false);
+
+    LayoutDensity density;
+    EXPECT_EQ(enumerator.countDensity(observation, density), 0u);
+    EXPECT_EQ(enumerator.forEachLayout(observation, [](const std::uint16_t*, int) {}), 0u);
+}
+
+TEST(LayoutEnumeratorTests, DensityShooterBeatsHuntShooter)
+{
+    SimulationConfig config;
+    config.games = 100;
+    config.threads = 2;
+    config.seed = 5;
+
+    config.makeShooter = [] { return std::make_unique<HuntShooter>(); };
+    SimulationResult hunt = SimulationRunner(config).run();
+    config.makeShooter = [] { return std::make_unique<DensityShooter>(GameFactory::CLASSIC_MAX_SHIPS); };
+    SimulationResult density = SimulationRunner(config).run();
+
+    EXPECT_EQ(density.completed, config.games);
+    EXPECT_LT(density.meanShotsToWin(), hunt.meanShotsToWin());
+}
+
+TEST(LayoutEnumeratorTests, DensityShooterLeavesDestroyedPlanesAlone)
+{
+    const LayoutEnumerator enumerator(GameFactory::CLASSIC_MAX_SHIPS);
+    SplitMix64 rng{ 11 };
+    for (int game = 0; game < 4; ++game) {
+        Board board;
+        RandomPlacement placement;
+        ASSERT_TRUE(placement.placeShips(Board::SIZE, GameFactory::CLASSIC_MAX_SHIPS,
+            [&board](const Ship& plane) { return board.placeShip(plane); }, rng));
+
+        DensityShooter shooter;
+        shooter.reset(Board::SIZE);
+        LayoutObservation seen;
+        while (!board.allShipsSunk()) {
+            const Position target = shooter.nextShot(rng);
+            ASSERT_GE(target.m_x, 0);
+            const int cell = target.m_y * Board::SIZE + target.m_x;
+
+            // some consistent layout has a plane that is still alive on the target
+            bool live = false;
+            enumerator.forEachLayout(seen, [&](const std::uint16_t* ids, int planes) {
+                for (int i = 0; i < planes && !live; ++i) {
+                    const auto& candidate = PlacementTable::PLACEMENTS[ids[i]];
+                    live = !seen.heads.test(candidate.head) && candidate.mask.test(cell);
+                }
+            });
+            ASSERT_TRUE(live) << "shot at (" << target.m_x << ", " << target.m_y << ")";
+
+            board.receiveShot(target);
+            const Cell result = board.getCellInfo(target);
+            shooter.onShotResult(result);
+            seen.record(cell, result.state == CellState::Hit, result.isHead);
+        }
+    }
+}
+
+TEST(LayoutEnumeratorTests, HeadHunterBeatsPartHunter)
+{
+    SimulationConfig config;
+    config.games = 100;
+    config.threads = 2;
+    config.seed = 5;
+
+    config.makeShooter = [] { return std::make_unique<DensityShooter>(GameFactory::CLASSIC_MAX_SHIPS); };
+    SimulationResult parts = SimulationRunner(config).run();
+    config.makeShooter = [] { return std::make_unique<DensityShooter>(GameFactory::CLASSIC_MAX_SHIPS, DensityShooter::Aim::Heads); };
+    SimulationResult heads = SimulationRunner(config).run();
+
+    EXPECT_EQ(heads.completed, config.games);
+    EXPECT_LT(heads.meanShotsToWin(), parts.meanShotsToWin());
+}
@@ -0,0 +1,100 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "DensityShooter.h"
+#include "LayoutSampler.h"
+#include "Simulation.h"
+
+namespace {
+    SamplerConfig FixedSamples(std::uint64_t samples, int threads = 1)
+    {
+        SamplerConfig config;
+        config.threads = threads;
+        config.seed = 9;
+        config.budget = std::chrono::seconds(10);
+        config.maxSamples = samples;
+        return config;
+    }
+}
+
+TEST(LayoutSamplerTests, SamplesAgreeWithObservation)
+{
+    LayoutSampler sampler(32, 5);
+    sampler.record(10, 10, true, false);
+    sampler.record(10, 9, true, true);
+    sampler.record(20, 20, true, false);
+    sampler.record(0, 0, false, false);
+    sampler.record(11, 11, false, false);
+
+    SampleHeatmap heatmap = sampler.sample(FixedSamples(500));
+    ASSERT_EQ(heatmap.samples, 500u);
+    // the plane headed at (10,9) is destroyed; (20,20) is too far away to be part of it
+    EXPECT_LE(heatmap.occupied[10 * 32 + 10], 500u);
+    EXPECT_EQ(heatmap.occupied[9 * 32 + 10], 0u);
+    EXPECT_EQ(heatmap.occupied[20 * 32 + 20], 500u);
+    EXPECT_EQ(heatmap.heads[9 * 32 + 10], 500u);
+    EXPECT_EQ(heatmap.heads[10 * 32 + 10], 0u);
+    EXPECT_EQ(heatmap.occupied[0], 0u);
+    EXPECT_EQ(heatmap.occupied[11 * 32 + 11], 0u);
+
+    std::uint64_t heads = 0;
+    for (auto count : heatmap.heads)
+        heads += count;
+    EXPECT_EQ(heads, 500u * 5);
+}
+
+TEST(LayoutSamplerTests, SameSeedSameHeatmap)
+{
+    LayoutSampler sampler(20, 4);
+    sampler.record(5, 5, true, false);
+
+    SampleHeatmap first = sampler.sample(FixedSamples(300));
+    SampleHeatmap second = sampler.sample(FixedSamples(300));
+    EXPECT_EQ(first.occupied, second.occupied);
+    EXPECT_EQ(first.heads, second.heads);
+}
+
+TEST(LayoutSamplerTests, ThreadsMergeTheirSamples)
+{
+    LayoutSampler sampler(32, 3);
+    SampleHeatmap heatmap = sampler.sample(FixedSamples(400, 4));
+    EXPECT_EQ(heatmap.samples, 400u);
+
+    std::uint64_t parts = 0;
+    for (auto count : heatmap.occupied)
+        parts += count;
+    EXPECT_EQ(parts, 400u * 3 * PlacementTable::PART_COUNT);
+}
+
+TEST(LayoutSamplerTests, StopsAtTheBudget)
+{
+    LayoutSampler sampler(32, 6);
+    SamplerConfig config;
+    config.threads = 2;
+    config.budget = std::chrono::milliseconds(5);
+
+    auto start = std::chrono::steady_clock::now();
+    SampleHeatmap heatmap = sampler.sample(config);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GT(heatmap.samples, 0u);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST(LayoutSamplerTests, DensityShooterPlaysLargeBoards)
+{
+    SimulationConfig config;
+    config.games = 6;
+    config.threads = 2;
+    config.boardSize = 16;
+    config.maxShips = 4;
+    config.makeShooter = [] {
+        auto shooter = std::make_unique<DensityShooter>(4);
+        SamplerConfig sampling;
+        sampling.budget = std::chrono::microseconds(200);
+        shooter->setSampling(sampling);
+        return shooter;
+    };
+
+    SimulationResult result = SimulationRunner(config).run();
+    EXPECT_EQ(result.completed, config.games);
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "LayoutEnumerator.h"
+
+// Planes at (4,2) Up and (2,6) Up; one body hit, the first head, and a few misses. Shared by
+// the layout enumerator, database and symmetry tests.
+inline LayoutObservation SomeShots()
+{
+    LayoutObservation observation;
+    observation.record(4 + 3 * 10, true, false);
+    observation.record(4 + 2 * 10, true, true);
+    observation.record(0, false, false);
+    observation.record(9 + 9 * 10, false, false);
+    observation.record(7 + 7 * 10, false, false);
+    return observation;
+}
@@ -0,0 +1,227 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "MatchDriver.h"
+#include "MoveSources.h"
+#include "Executors.h"
+#include "GameFactory.h"
+#include "RandomStrategies.h"
+
+namespace {
+    std::unique_ptr<BotMoveSource> MakeBot(std::uint64_t seed, bool hunt = false)
+    {
+        std::unique_ptr<IShootingStrategy> shooter;
+        if (hunt)
+            shooter = std::make_unique<HuntShooter>();
+        else
+            shooter = std::make_unique<RandomShooter>();
+        return std::make_unique<BotMoveSource>(std::make_unique<RandomPlacement>(), std::move(shooter), seed);
+    }
+
+    std::unique_ptr<IGame> MakeGame(int maxShips = 3)
+    {
+        GameFactory factory("A", "B", GameFactory::CLASSIC_BOARD_SIZE, maxShips);
+        return factory.create();
+    }
+
+    Move Place(int x, int y, Orientation orientation)
+    {
+        Move move;
+        move.kind = Move::Kind::PlaceShip;
+        move.x = static_cast<std::int16_t>(x);
+        move.y = static_cast<std::int16_t>(y);
+        move.orientation = orientation;
+        return move;
+    }
+
+    Move Shot(int cell)
+    {
+        Move move;
+        move.kind = Move::Kind::Shoot;
+        move.x = static_cast<std::int16_t>(cell % 10);
+        move.y = static_cast<std::int16_t>(cell / 10);
+        return move;
+    }
+}
+
+TEST(MatchDriverTests, BotsPlayToTheEnd)
+{
+    ManualExecutor executor;
+    auto first = MakeBot(1);
+    auto second = MakeBot(2, true);
+    MatchDriver driver(MakeGame(), *first, *second, executor);
+
+    driver.start();
+    EXPECT_FALSE(driver.isFinished());
+    executor.runAll();
+
+    ASSERT_TRUE(driver.isFinished());
+    EXPECT_TRUE(driver.getOutcome().completed);
+    EXPECT_GE(driver.getOutcome().winner, 0);
+    EXPECT_GT(driver.getOutcome().shots, 0);
+    EXPECT_EQ(driver.getOutcome().rejectedMoves, 0);
+    EXPECT_EQ(driver.getGame().getState(), GameState::GameOver);
+}
+
+TEST(MatchDriverTests, InputSideWaitsWithoutAThread)
+{
+    ManualExecutor executor;
+    InputMoveSource human;
+    auto bot = MakeBot(7);
+    MatchDriver driver(MakeGame(1), human, *bot, executor);
+
+    EXPECT_FALSE(human.submit(Place(4, 2, Orientation::Up)));
+    driver.start();
+    executor.runAll();
+    ASSERT_TRUE(human.isWaiting());
+    EXPECT_EQ(human.getRequest().kind, MoveRequest::Kind::Placement);
+    EXPECT_EQ(executor.pending(), 0u);
+
+    ASSERT_TRUE(human.submit(Place(4, 2, Orientation::Up)));
+    EXPECT_FALSE(human.isWaiting());
+    executor.runAll();
+
+    // bot placed, the human fires first
+    ASSERT_TRUE(human.isWaiting());
+    EXPECT_EQ(human.getRequest().kind, MoveRequest::Kind::Shot);
+
+    Move outside = Shot(0);
+    outside.x = 12;
+    ASSERT_TRUE(human.submit(outside));
+    executor.runAll();
+    EXPECT_EQ(human.getRejectedCount(), 1u);
+    ASSERT_TRUE(human.isWaiting());
+
+    for (int cell = 0; cell < 100 && !driver.isFinished(); ++cell) {
+        if (human.isWaiting())
+            human.submit(Shot(cell));
+        executor.runAll();
+    }
+
+    ASSERT_TRUE(driver.isFinished());
+    EXPECT_TRUE(driver.getOutcome().completed);
+    EXPECT_EQ(driver.getOutcome().rejectedMoves, 1);
+}
+
+TEST(MatchDriverTests, ResignEndsTheMatch)
+{
+    ManualExecutor executor;
+    InputMoveSource human;
+    auto bot = MakeBot(3);
+    MatchDriver driver(MakeGame(), human, *bot, executor);
+
+    driver.start();
+    executor.runAll();
+    ASSERT_TRUE(human.submit(Move{}));
+    executor.runAll();
+
+    ASSERT_TRUE(driver.isFinished());
+    EXPECT_FALSE(driver.getOutcome().completed);
+    EXPECT_EQ(driver.getOutcome().winner, 1);
+}
+
+TEST(MatchDriverTests, RejectionsCountPerSide)
+{
+    ManualExecutor executor;
+    InputMoveSource first;
+    InputMoveSource second;
+    MatchDriver driver(MakeGame(1), first, second, executor);
+
+    driver.start();
+    executor.runAll();
+    // one short of resigning: a shot is no placement
+    for (int i = 0; i < MatchDriver::MAX_REJECTED_MOVES - 1; ++i) {
+        ASSERT_TRUE(first.submit(Shot(0)));
+        executor.runAll();
+    }
+    ASSERT_TRUE(first.submit(Place(4, 2, Orientation::Up)));
+    executor.runAll();
+
+    // the other side's first mistake does not cost it the match
+    ASSERT_TRUE(second.submit(Shot(0)));
+    executor.runAll();
+    EXPECT_FALSE(driver.isFinished());
+    ASSERT_TRUE(second.submit(Place(4, 2, Orientation::Up)));
+    executor.runAll();
+    ASSERT_TRUE(first.isWaiting());
+    EXPECT_EQ(first.getRequest().kind, MoveRequest::Kind::Shot);
+
+    ASSERT_TRUE(first.submit(Move{}));
+    executor.runAll();
+    ASSERT_TRUE(driver.isFinished());
+    EXPECT_EQ(driver.getOutcome().winner, 1);
+    EXPECT_EQ(driver.getOutcome().rejectedMoves, MatchDriver::MAX_REJECTED_MOVES);
+}
+
+TEST(MatchDriverTests, DestroyingDriverCancelsPendingInput)
+{
+    ManualExecutor executor;
+    InputMoveSource human;
+    auto bot = MakeBot(4);
+    {
+        MatchDriver driver(MakeGame(), human, *bot, executor);
+        driver.start();
+        executor.runAll();
+        ASSERT_TRUE(human.isWaiting());
+    }
+    EXPECT_FALSE(human.isWaiting());
+    EXPECT_FALSE(human.submit(Place(4, 2, Orientation::Up)));
+}
+
+TEST(MatchDriverTests, ManyMixedMatchesOnFewThreads)
+{
+    constexpr int BOT_MATCHES = 1000;
+    constexpr int HUMAN_MATCHES = 50;
+
+    ThreadPoolExecutor executor(3);
+    std::atomic<int> finished{ 0 };
+
+    std::vector<std::unique_ptr<BotMoveSource>> bots;
+    std::vector<std::unique_ptr<InputMoveSource>> humans(HUMAN_MATCHES);
+    std::vector<std::unique_ptr<MatchDriver>> drivers;
+
+    for (int i = 0; i < BOT_MATCHES + HUMAN_MATCHES; ++i) {
+        bots.push_back(MakeBot(100 + i, i % 2 == 0));
+        IMoveSource* first;
+        if (i < BOT_MATCHES) {
+            bots.push_back(MakeBot(5000 + i, i % 3 == 0));
+            first = bots.back().get();
+        }
+        else {
+            humans[i - BOT_MATCHES] = std::make_unique<InputMoveSource>();
+            first = humans[i - BOT_MATCHES].get();
+        }
+        drivers.push_back(std::make_unique<MatchDriver>(MakeGame(i < BOT_MATCHES ? 3 : 2), *first, *bots[bots.size() - (i < BOT_MATCHES ? 2 : 1)], executor));
+        drivers.back()->setOnFinished([&finished](const MatchOutcome&) { finished.fetch_add(1); });
+    }
+    for (auto& driver : drivers)
+        driver->start();
+
+    // the test thread plays every human side: two fixed planes, then cells in order
+    const Move fleet[2] = { Place(4, 2, Orientation::Up), Place(2, 6, Orientation::Up) };
+    std::vector<int> nextCell(HUMAN_MATCHES, 0);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (finished.load() < BOT_MATCHES + HUMAN_MATCHES && std::chrono::steady_clock::now() < deadline) {
+        for (int h = 0; h < HUMAN_MATCHES; ++h) {
+            if (!humans[h]->isWaiting())
+                continue;
+            MoveRequest request = humans[h]->getRequest();
+            if (request.kind == MoveRequest::Kind::Placement)
+                humans[h]->submit(fleet[request.placed]);
+            else
+                humans[h]->submit(Shot(nextCell[h]++));
+        }
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(finished.load(), BOT_MATCHES + HUMAN_MATCHES);
+    for (auto& driver : drivers) {
+        ASSERT_TRUE(driver->isFinished());
+        EXPECT_TRUE(driver->getOutcome().completed);
+        EXPECT_EQ(driver->getOutcome().rejectedMoves, 0);
+    }
+}
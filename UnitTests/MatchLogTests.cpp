@@ -0,0 +1,268 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "MatchLog.h"
+#include "GameFactory.h"
+
+namespace {
+    struct RecordedMatch {
+        std::unique_ptr<IGame> game;
+        std::unique_ptr<MatchRecorder> recorder;
+    };
+
+    // Two planes each, placed and ready for player 1's first shot.
+    RecordedMatch StartMatch(int size = GameFactory::CLASSIC_BOARD_SIZE)
+    {
+        GameFactory factory("A", "B", size, 2);
+        RecordedMatch match;
+        match.game = factory.create();
+        match.recorder = std::make_unique<MatchRecorder>(*match.game);
+        IGame& game = *match.game;
+
+        game.startGame();
+        EXPECT_TRUE(game.placeShip(Position(4, 2), 10, Orientation::Up));
+        EXPECT_TRUE(game.placeShip(Position(2, 6), 10, Orientation::Up));
+        game.switchTurn();
+        EXPECT_TRUE(game.placeShip(Position(5, 6), 10, Orientation::Down));
+        EXPECT_TRUE(game.placeShip(Position(7, 1), 10, Orientation::Up));
+        game.switchTurn();
+        return match;
+    }
+
+    // Player 1 downs both planes of player 2 by their heads on its third shot.
+    RecordedMatch PlayShortMatch(int size = GameFactory::CLASSIC_BOARD_SIZE)
+    {
+        RecordedMatch match = StartMatch(size);
+        IGame& game = *match.game;
+        game.shoot(Position(0, 0));
+        game.shoot(Position(4, 3));
+        game.shoot(Position(5, 6));
+        game.shoot(Position(9, 9));
+        game.shoot(Position(7, 1));
+        match.recorder->poll();
+        return match;
+    }
+}
+
+TEST(MatchLogTests, RecordsAreCompact)
+{
+    MatchLog log;
+    MatchRecord place;
+    place.op = MatchOp::PlaceShip;
+    place.x = 4;
+    place.y = 2;
+    place.orientation = Orientation::Left;
+    log.append(place);
+    EXPECT_EQ(log.getBytes().size(), MatchLog::HEADER_SIZE + 2);
+
+    MatchRecord shot;
+    shot.op = MatchOp::Shoot;
+    shot.turnNumber = 2;
+    log.append(shot);
+    EXPECT_EQ(log.getBytes().size(), MatchLog::HEADER_SIZE + 4);
+
+    MatchRecord far;
+    far.op = MatchOp::SwitchTurn;
+    far.turnNumber = 1000;
+    log.append(far);
+    EXPECT_EQ(log.getBytes().size(), MatchLog::HEADER_SIZE + 7);
+    EXPECT_EQ(log.getRecordCount(), 3u);
+    EXPECT_EQ(log.getPlyCount(), 3u);
+}
+
+TEST(MatchLogTests, RoundTripsRecords)
+{
+    MatchLog log(20, 4);
+    std::vector<MatchRecord> written(4);
+    written[0].op = MatchOp::StateChanged;
+    written[0].state = GameState::PlacingShips;
+    written[1].op = MatchOp::PlaceShip;
+    written[1].x = 17;
+    written[1].y = 19;
+    written[1].orientation = Orientation::Right;
+    written[2].op = MatchOp::Shoot;
+    written[2].player = 1;
+    written[2].x = 3;
+    written[2].y = 18;
+    written[2].hit = true;
+    written[2].head = true;
+    written[2].turnNumber = 7;
+    written[3].op = MatchOp::StateChanged;
+    written[3].state = GameState::PlacingShips;
+    written[3].turnNumber = 0;
+    for (const auto& record : written)
+        log.append(record);
+
+    MatchLog loaded;
+    ASSERT_TRUE(loaded.load(log.getBytes().data(), log.getBytes().size()));
+    EXPECT_EQ(loaded.getBoardSize(), 20);
+    EXPECT_EQ(loaded.getMaxShips(), 4);
+    EXPECT_EQ(loaded.getRecordCount(), 4u);
+    EXPECT_EQ(loaded.getPlyCount(), 2u);
+
+    MatchLog::Reader reader(loaded);
+    MatchRecord record;
+    for (const auto& expected : written) {
+        ASSERT_TRUE(reader.next(record));
+        EXPECT_EQ(record.op, expected.op);
+        EXPECT_EQ(record.player, expected.player);
+        EXPECT_EQ(record.turnNumber, expected.turnNumber);
+        if (expected.op == MatchOp::PlaceShip || expected.op == MatchOp::Shoot) {
+            EXPECT_EQ(record.x, expected.x);
+            EXPECT_EQ(record.y, expected.y);
+        }
+        EXPECT_EQ(record.orientation, expected.orientation);
+        EXPECT_EQ(record.hit, expected.hit);
+        EXPECT_EQ(record.head, expected.head);
+        EXPECT_EQ(record.state, expected.state);
+    }
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_FALSE(reader.failed());
+}
+
+TEST(MatchLogTests, LoadRejectsTruncatedLog)
+{
+    MatchLog log;
+    MatchRecord shot;
+    shot.op = MatchOp::Shoot;
+    log.append(shot);
+
+    auto bytes = log.getBytes();
+    bytes.pop_back();
+    EXPECT_FALSE(log.load(bytes.data(), bytes.size()));
+    EXPECT_EQ(log.getRecordCount(), 1u);
+
+    bytes = log.getBytes();
+    bytes[0] = MatchLog::VERSION + 1;
+    EXPECT_FALSE(log.load(bytes.data(), bytes.size()));
+}
+
+TEST(MatchLogTests, RecorderLogsWholeMatch)
+{
+    auto match = PlayShortMatch();
+    auto& game = match.game;
+    auto& recorder = match.recorder;
+    const MatchLog& log = recorder->getLog();
+
+    EXPECT_EQ(game->getState(), GameState::GameOver);
+    EXPECT_EQ(recorder->getDropped(), 0u);
+    // 4 placements, 2 switches, 5 shots
+    EXPECT_EQ(log.getPlyCount(), 11u);
+    // start, InProgress, SwitchingTurn after 4 shots, GameOver
+    EXPECT_EQ(log.getRecordCount(), 18u);
+    EXPECT_LE(log.getBytes().size(), MatchLog::HEADER_SIZE + 18 + 9);
+}
+
+TEST(MatchLogTests, ReplayRebuildsFinalPosition)
+{
+    auto match = PlayShortMatch();
+    auto& game = match.game;
+    auto& recorder = match.recorder;
+
+    auto replayed = MatchReplay::replay(recorder->getLog());
+    ASSERT_NE(replayed, nullptr);
+    EXPECT_EQ(replayed->getState(), GameState::GameOver);
+    for (int y = 0; y < 10; ++y)
+        for (int x = 0; x < 10; ++x) {
+            Position p(x, y);
+            EXPECT_EQ(replayed->getPlayer1()->getBoard()->getCellState(p), game->getPlayer1()->getBoard()->getCellState(p));
+            EXPECT_EQ(replayed->getPlayer2()->getBoard()->getCellState(p), game->getPlayer2()->getBoard()->getCellState(p));
+        }
+}
+
+TEST(MatchLogTests, ReplayStopsAtPly)
+{
+    auto match = PlayShortMatch();
+    auto& recorder = match.recorder;
+
+    auto placing = MatchReplay::replay(recorder->getLog(), 3);
+    ASSERT_NE(placing, nullptr);
+    EXPECT_EQ(placing->getState(), GameState::PlacingShips);
+    EXPECT_EQ(placing->getPlayer1()->getBoard()->getShipsCount(), 2);
+    EXPECT_EQ(placing->getCurrentPlayer().lock(), placing->getPlayer2());
+
+    auto playing = MatchReplay::replay(recorder->getLog(), 8);
+    ASSERT_NE(playing, nullptr);
+    EXPECT_EQ(playing->getState(), GameState::SwitchingTurn);
+    EXPECT_EQ(playing->getPlayer2()->getBoard()->getCellState(Position(0, 0)), CellState::Miss);
+    EXPECT_EQ(playing->getPlayer1()->getBoard()->getCellState(Position(4, 3)), CellState::Hit);
+    EXPECT_EQ(playing->getPlayer2()->getBoard()->getCellState(Position(5, 6)), CellState::Ship);
+    EXPECT_FALSE(playing->isGameOver());
+}
+
+TEST(MatchLogTests, ReplayWorksOnLargeBoards)
+{
+    auto match = PlayShortMatch(20);
+    auto& recorder = match.recorder;
+
+    auto replayed = MatchReplay::replay(recorder->getLog());
+    ASSERT_NE(replayed, nullptr);
+    EXPECT_EQ(replayed->getGridSize(), 20);
+    EXPECT_EQ(replayed->getState(), GameState::GameOver);
+}
+
+TEST(MatchLogTests, ReplayRejectsTamperedLog)
+{
+    MatchLog log;
+    MatchRecord start;
+    start.op = MatchOp::StateChanged;
+    start.state = GameState::PlacingShips;
+    log.append(start);
+
+    MatchRecord place;
+    place.op = MatchOp::PlaceShip;
+    place.x = 4;
+    place.y = 2;
+    log.append(place);
+    place.x = 4;
+    place.y = 3;
+    log.append(place);
+
+    EXPECT_NE(MatchReplay::replay(log, 1), nullptr);
+    EXPECT_EQ(MatchReplay::replay(log), nullptr);
+}
+
+TEST(MatchLogTests, ReplayFollowsRepeatedShot)
+{
+    auto match = StartMatch();
+    IGame& game = *match.game;
+    game.shoot(Position(7, 2));
+    game.shoot(Position(0, 0));
+    // the game takes the second shot at a hit cell as a miss
+    game.shoot(Position(7, 2));
+    match.recorder->poll();
+
+    auto replayed = MatchReplay::replay(match.recorder->getLog());
+    ASSERT_NE(replayed, nullptr);
+    EXPECT_EQ(replayed->getPlayer2()->getBoard()->getCellState(Position(7, 2)), CellState::Hit);
+    EXPECT_EQ(replayed->getCurrentPlayer().lock(), replayed->getPlayer2());
+}
+
+TEST(MatchLogTests, OffBoardShotIsNotLoggedAsAnotherCell)
+{
+    auto match = StartMatch();
+    IGame& game = *match.game;
+    game.shoot(Position(12, 0));
+    match.recorder->poll();
+
+    EXPECT_EQ(match.recorder->getSkipped(), 1u);
+    MatchLog::Reader reader(match.recorder->getLog());
+    MatchRecord record;
+    while (reader.next(record))
+        EXPECT_NE(record.op, MatchOp::Shoot);
+    // the lost turn shows: the log no longer replays
+    EXPECT_EQ(MatchReplay::replay(match.recorder->getLog()), nullptr);
+}
+
+TEST(MatchLogTests, RejectsSizesTheHeaderCannotHold)
+{
+    MatchLog log(MatchLog::MAX_BOARD_SIZE + 1, 3);
+    EXPECT_FALSE(log.isValid());
+    MatchRecord start;
+    EXPECT_FALSE(log.append(start));
+    EXPECT_EQ(log.getRecordCount(), 0u);
+    EXPECT_EQ(MatchReplay::replay(log), nullptr);
+
+    EXPECT_FALSE(MatchLog(0, 3).isValid());
+    EXPECT_TRUE(MatchLog(MatchLog::MAX_BOARD_SIZE, 3).isValid());
+}
@@ -0,0 +1,40 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "PlacementTable.h"
+#include "Ship.h"
+#include "Position.h"
+#include "Orientation.h"
+
+TEST(PlacementTableTests, CountsEveryInBoundsPlacement)
+{
+    // the plane spans 5x4 cells, so each orientation fits in 6 * 7 head positions
+    EXPECT_EQ(PlacementTable::COUNT, 4 * 6 * 7);
+    static_assert(PlacementTable::find(9, 9, Orientation::Up) == nullptr, "plane leaves the board");
+}
+
+TEST(PlacementTableTests, EntriesMatchShipLayout)
+{
+    for (const auto& placement : PlacementTable::PLACEMENTS)
+    {
+        Position head(placement.head % PlacementTable::BOARD_SIZE, placement.head / PlacementTable::BOARD_SIZE);
+        Ship ship(head, placement.orientation);
+        const auto& parts = ship.getParts();
+
+        ASSERT_EQ(parts.size(), placement.cells.size());
+        EXPECT_EQ(placement.mask.count(), PlacementTable::PART_COUNT);
+        for (size_t i = 0; i < parts.size(); ++i)
+        {
+            int cell = parts[i].getPosition().m_y * PlacementTable::BOARD_SIZE + parts[i].getPosition().m_x;
+            EXPECT_EQ(placement.cells[i], cell);
+            EXPECT_TRUE(placement.mask.test(cell));
+        }
+        EXPECT_EQ(PlacementTable::find(head.m_x, head.m_y, placement.orientation), &placement);
+    }
+}
+
+TEST(PlacementTableTests, OutOfBoundsHeadsHaveNoPlacement)
+{
+    EXPECT_EQ(PlacementTable::find(-1, 0, Orientation::Up), nullptr);
+    EXPECT_EQ(PlacementTable::find(0, 10, Orientation::Left), nullptr);
+    EXPECT_NE(PlacementTable::find(2, 0, Orientation::Up), nullptr);
+}
@@ -0,0 +1,127 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "Protocol.h"
+
+using Protocol::DecodeResult;
+using Protocol::Frame;
+using Protocol::FrameType;
+
+namespace {
+    Frame RoundTrip(const Frame& frame)
+    {
+        std::vector<std::uint8_t> bytes;
+        Protocol::encode(frame, bytes);
+        EXPECT_EQ(bytes.size(), Protocol::HEADER_SIZE + Protocol::payloadSize(frame.type));
+
+        Frame decoded;
+        std::size_t consumed = 0;
+        EXPECT_EQ(Protocol::decode(bytes.data(), bytes.size(), decoded, consumed), DecodeResult::Ok);
+        EXPECT_EQ(consumed, bytes.size());
+        return decoded;
+    }
+}
+
+TEST(ProtocolTests, ShotResultIsFiveBytes)
+{
+    Frame shot;
+    shot.type = FrameType::ShotFired;
+    shot.x = 7;
+    shot.y = 3;
+    shot.player = 1;
+    shot.hit = true;
+    shot.head = true;
+    shot.state = GameState::GameOver;
+
+    std::vector<std::uint8_t> bytes;
+    Protocol::encode(shot, bytes);
+    EXPECT_EQ(bytes.size(), 5u);
+
+    Frame decoded = RoundTrip(shot);
+    EXPECT_EQ(decoded.type, FrameType::ShotFired);
+    EXPECT_EQ(decoded.x, 7);
+    EXPECT_EQ(decoded.y, 3);
+    EXPECT_EQ(decoded.player, 1);
+    EXPECT_TRUE(decoded.hit);
+    EXPECT_TRUE(decoded.head);
+    EXPECT_EQ(decoded.state, GameState::GameOver);
+}
+
+TEST(ProtocolTests, CommandsRoundTrip)
+{
+    Frame start = RoundTrip(Protocol::newMatch(0x0123456789ABCDEFull));
+    EXPECT_EQ(start.type, FrameType::NewMatch);
+    EXPECT_EQ(start.seed, 0x0123456789ABCDEFull);
+
+    Frame place = RoundTrip(Protocol::placeShip(4, 2, Orientation::Left));
+    EXPECT_EQ(place.type, FrameType::PlaceShip);
+    EXPECT_EQ(place.x, 4);
+    EXPECT_EQ(place.y, 2);
+    EXPECT_EQ(place.orientation, Orientation::Left);
+
+    Frame shot = RoundTrip(Protocol::shoot(9, 0));
+    EXPECT_EQ(shot.type, FrameType::Shoot);
+    EXPECT_EQ(shot.x, 9);
+    EXPECT_EQ(shot.y, 0);
+
+    Frame error = RoundTrip(Protocol::error(Protocol::ErrorCode::AlreadyShot, FrameType::Shoot));
+    EXPECT_EQ(error.error, Protocol::ErrorCode::AlreadyShot);
+    EXPECT_EQ(error.rejected, FrameType::Shoot);
+}
+
+TEST(ProtocolTests, PipelinedFramesDecodeInOrder)
+{
+    std::vector<std::uint8_t> bytes;
+    Protocol::encode(Protocol::placeShip(4, 2, Orientation::Up), bytes);
+    Protocol::encode(Protocol::shoot(1, 1), bytes);
+    Protocol::encode(Protocol::shoot(2, 2), bytes);
+
+    std::vector<Frame> frames;
+    std::size_t offset = 0;
+    Frame frame;
+    std::size_t consumed = 0;
+    while (Protocol::decode(bytes.data() + offset, bytes.size() - offset, frame, consumed) == DecodeResult::Ok) {
+        frames.push_back(frame);
+        offset += consumed;
+    }
+
+    EXPECT_EQ(offset, bytes.size());
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].type, FrameType::PlaceShip);
+    EXPECT_EQ(frames[1].x, 1);
+    EXPECT_EQ(frames[2].x, 2);
+}
+
+TEST(ProtocolTests, PartialFrameNeedsMore)
+{
+    std::vector<std::uint8_t> bytes;
+    Protocol::encode(Protocol::newMatch(42), bytes);
+
+    Frame frame;
+    std::size_t consumed = 0;
+    for (std::size_t size = 0; size < bytes.size(); ++size)
+        EXPECT_EQ(Protocol::decode(bytes.data(), size, frame, consumed), DecodeResult::NeedMore);
+    EXPECT_EQ(Protocol::decode(bytes.data(), bytes.size(), frame, consumed), DecodeResult::Ok);
+    EXPECT_EQ(frame.seed, 42u);
+}
+
+TEST(ProtocolTests, BadFramesAreSkipped)
+{
+    // wrong length for a Shoot, an unknown type, a bad orientation, then a good frame
+    std::vector<std::uint8_t> bytes = { 2, 0x03, 5, 3, 0x7F, 1, 2, 4, 0x02, 1, 1, 9 };
+    Protocol::encode(Protocol::shoot(3, 4), bytes);
+
+    Frame frame;
+    std::size_t offset = 0;
+    std::size_t consumed = 0;
+    EXPECT_EQ(Protocol::decode(bytes.data(), bytes.size(), frame, consumed), DecodeResult::Malformed);
+    offset += consumed;
+    EXPECT_EQ(Protocol::decode(bytes.data() + offset, bytes.size() - offset, frame, consumed), DecodeResult::UnknownType);
+    offset += consumed;
+    EXPECT_EQ(Protocol::decode(bytes.data() + offset, bytes.size() - offset, frame, consumed), DecodeResult::Malformed);
+    offset += consumed;
+    EXPECT_EQ(Protocol::decode(bytes.data() + offset, bytes.size() - offset, frame, consumed), DecodeResult::Ok);
+    EXPECT_EQ(frame.type, FrameType::Shoot);
+    EXPECT_EQ(frame.x, 3);
+    EXPECT_EQ(frame.y, 4);
+}
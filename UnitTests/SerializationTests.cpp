@@ -0,0 +1,124 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include "Serialization.h"
+#include "GameFactory.h"
+#include "Board.h"
+#include "Game.h"
+#include "Ship.h"
+#include "Position.h"
+#include "Orientation.h"
+
+TEST(SerializationTests, BoardRoundTrip)
+{
+    Board original;
+    Ship first(Position(2, 0), Orientation::Up);
+    Ship second(Position(6, 9), Orientation::Down);
+    ASSERT_TRUE(original.placeShip(first));
+    ASSERT_TRUE(original.placeShip(second));
+    original.receiveShot(first.getParts()[4].getPosition());
+    original.receiveShot(second.getHead());
+    original.receiveShot(Position(9, 0));
+
+    auto blob = Serialization::encodeBoard(original);
+    EXPECT_EQ(blob.size(), 32u);
+
+    Board decoded;
+    ASSERT_TRUE(Serialization::decodeBoard(blob, decoded));
+    ASSERT_EQ(decoded.getShipsCount(), 2);
+    EXPECT_EQ(decoded.getShips()[0].getHitMask(), original.getShips()[0].getHitMask());
+    EXPECT_EQ(decoded.getShips()[1].getHitMask(), original.getShips()[1].getHitMask());
+    EXPECT_EQ(decoded.getLayoutHash(), original.getLayoutHash());
+    EXPECT_EQ(decoded.getObservationHash(), original.getObservationHash());
+    for (int y = 0; y < Board::SIZE; ++y)
+        for (int x = 0; x < Board::SIZE; ++x)
+            EXPECT_EQ(decoded.getCellState(Position(x, y)), original.getCellState(Position(x, y)));
+}
+
+TEST(SerializationTests, RejectsUnknownVersion)
+{
+    Board board;
+    auto blob = Serialization::encodeBoard(board);
+    blob[0] = 0xFF;
+    EXPECT_FALSE(Serialization::decodeBoard(blob, board));
+}
+
+TEST(SerializationTests, GameRoundTrip)
+{
+    GameFactory factory;
+    auto source = factory.create();
+    auto& sourceGame = static_cast<Game&>(*source);
+    source->startGame();
+    ASSERT_TRUE(source->placeShip(Position(2, 0), 1, Orientation::Up));
+    source->switchTurn();
+    ASSERT_TRUE(source->placeShip(Position(5, 5), 1, Orientation::Left));
+    sourceGame.restore(0, GameState::InProgress, 1);
+    source->shoot(Position(5, 5));
+
+    Serialization::GameBlob blob{};
+    ASSERT_TRUE(Serialization::encodeGame(sourceGame, blob));
+
+    auto target = factory.create();
+    auto& targetGame = static_cast<Game&>(*target);
+    ASSERT_TRUE(Serialization::decodeGame(blob, targetGame));
+    EXPECT_EQ(target->getState(), source->getState());
+    EXPECT_EQ(target->getMaxShips(), 1);
+    EXPECT_EQ(targetGame.getCurrentPlayerIndex(), sourceGame.getCurrentPlayerIndex());
+    EXPECT_EQ(target->getPlayer2()->getBoard()->getCellState(Position(5, 5)), CellState::Hit);
+    EXPECT_TRUE(target->isGameOver());
+}
+
+TEST(SerializationTests, RejectedBoardIsLeftUntouched)
+{
+    Board source;
+    ASSERT_TRUE(source.placeShip(Ship(Position(2, 0), Orientation::Up)));
+    ASSERT_TRUE(source.placeShip(Ship(Position(6, 9), Orientation::Down)));
+    auto blob = Serialization::encodeBoard(source);
+    blob[3] = blob[2];      // the second plane lands on the first
+
+    Board board;
+    Ship kept(Position(5, 5), Orientation::Left);
+    ASSERT_TRUE(board.placeShip(kept));
+    EXPECT_FALSE(Serialization::decodeBoard(blob, board));
+    ASSERT_EQ(board.getShipsCount(), 1);
+    EXPECT_EQ(board.getShips()[0].getHead().m_x, kept.getHead().m_x);
+    EXPECT_EQ(board.getShips()[0].getOrientation(), kept.getOrientation());
+}
+
+TEST(SerializationTests, GameDecodeIsAllOrNothing)
+{
+    GameFactory factory;
+    auto source = factory.create();
+    auto& sourceGame = static_cast<Game&>(*source);
+    source->startGame();
+    ASSERT_TRUE(source->placeShip(Position(2, 0), 1, Orientation::Up));
+    source->switchTurn();
+    ASSERT_TRUE(source->placeShip(Position(5, 5), 1, Orientation::Left));
+
+    Serialization::GameBlob good{};
+    ASSERT_TRUE(Serialization::encodeGame(sourceGame, good));
+
+    auto target = factory.create();
+    auto& targetGame = static_cast<Game&>(*target);
+
+    // the second board names a placement id that does not exist
+    auto badSecond = good;
+    badSecond[4 + Serialization::BOARD_BLOB_SIZE + 2] = 0xFF;
+    EXPECT_FALSE(Serialization::decodeGame(badSecond, targetGame));
+    EXPECT_EQ(target->getPlayer1()->getBoard()->getShipsCount(), 0);
+
+    // no planes allowed, more than a board holds, fewer than already placed
+    for (int maxShips : { 0, Serialization::MAX_PLANES + 1, 255 }) {
+        auto bad = good;
+        bad[3] = static_cast<std::uint8_t>(maxShips);
+        EXPECT_FALSE(Serialization::decodeGame(bad, targetGame));
+    }
+    auto tooFew = good;     // board 1 gets board 2's plane as a second one, over a limit of 1
+    tooFew[3] = 1;
+    tooFew[4 + 1] = 2;
+    tooFew[4 + 2 + 1] = tooFew[4 + Serialization::BOARD_BLOB_SIZE + 2];
+    EXPECT_FALSE(Serialization::decodeGame(tooFew, targetGame));
+    EXPECT_EQ(target->getPlayer1()->getBoard()->getShipsCount(), 0);
+
+    EXPECT_TRUE(Serialization::decodeGame(good, targetGame));
+    EXPECT_EQ(target->getPlayer1()->getBoard()->getShipsCount(), 1);
+}
@@ -96,3 +96,19 @@ TEST(ShipPartTests, HeadAndHitBehavior)
     head.markHit();
     EXPECT_TRUE(head.isHit());
 }
+
+TEST(ShipTests, HitMaskTracksParts)
+{
+    Ship s(Position(5, 5), Orientation::Left);
+    EXPECT_EQ(s.getHitMask(), 0);
+
+    s.hitPart(3);
+    EXPECT_EQ(s.getHitMask(), 1 << 3);
+    EXPECT_FALSE(s.isSunk());
+
+    Ship copy = s;
+    copy.hitPart(0);
+    EXPECT_EQ(copy.getHitMask(), Ship::ALL_PARTS);
+    EXPECT_TRUE(copy.isSunk());
+    EXPECT_FALSE(s.isSunk());
+}
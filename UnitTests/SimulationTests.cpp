@@ -0,0 +1,91 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <set>
+#include "Simulation.h"
+#include "RandomStrategies.h"
+#include "GameFactory.h"
+#include "Zobrist.h"
+
+TEST(SimulationTests, SplitMixMatchesReferenceOutput)
+{
+    // first outputs of the reference splitmix64 seeded with 0
+    SplitMix64 rng(0);
+    EXPECT_EQ(rng.next(), 0xE220A8397B1DCDAFull);
+    EXPECT_EQ(rng.next(), 0x6E789E6AA1B965F4ull);
+
+    static_assert(Zobrist::key(Zobrist::HitCell, 0) == SplitMix64::mix(0));
+    EXPECT_EQ(Zobrist::key(Zobrist::HitCell, 0), 0xE220A8397B1DCDAFull);
+}
+
+TEST(SimulationTests, RandomShooterCoversEveryCellOnce)
+{
+    RandomShooter shooter;
+    SplitMix64 rng(7);
+    shooter.reset(10);
+
+    std::set<int> seen;
+    for (int i = 0; i < 100; ++i) {
+        Position p = shooter.nextShot(rng);
+        ASSERT_TRUE(p.m_x >= 0 && p.m_x < 10 && p.m_y >= 0 && p.m_y < 10);
+        seen.insert(p.m_y * 10 + p.m_x);
+    }
+    EXPECT_EQ(seen.size(), 100u);
+    EXPECT_EQ(shooter.nextShot(rng).m_x, -1);
+}
+
+TEST(SimulationTests, RandomPlacementFillsBoard)
+{
+    GameFactory factory;
+    auto game = factory.create();
+    game->startGame();
+    SplitMix64 rng(3);
+    RandomPlacement placement;
+
+    auto tryPlace = [&game](const Ship& plane) {
+        return game->placeShip(plane.getHead(), Ship::PART_COUNT, plane.getOrientation());
+    };
+    ASSERT_TRUE(placement.placeShips(game->getGridSize(), game->getMaxShips(), tryPlace, rng));
+    EXPECT_TRUE(game->getPlayer1()->allShipsPlaced(game->getMaxShips()));
+}
+
+TEST(SimulationTests, AllGamesFinish)
+{
+    SimulationConfig config;
+    config.games = 200;
+    config.threads = 2;
+    config.makeShooter = [] { return std::make_unique<HuntShooter>(); };
+
+    SimulationResult result = SimulationRunner(config).run();
+    EXPECT_EQ(result.games, 200);
+    EXPECT_EQ(result.completed, 200);
+    EXPECT_GT(result.shots, 0u);
+    EXPECT_GT(result.shotsToWinPercentile(0.5), 0);
+    EXPECT_LE(result.shotsToWinPercentile(0.5), 100);
+}
+
+TEST(SimulationTests, ResultsDoNotDependOnThreadCount)
+{
+    SimulationConfig config;
+    config.games = 300;
+    config.seed = 42;
+
+    config.threads = 1;
+    SimulationResult single = SimulationRunner(config).run();
+    config.threads = 4;
+    SimulationResult multi = SimulationRunner(config).run();
+
+    EXPECT_EQ(single.shots, multi.shots);
+    EXPECT_EQ(single.player1Wins, multi.player1Wins);
+    EXPECT_EQ(single.shotsToWin, multi.shotsToWin);
+}
+
+TEST(SimulationTests, RunsOnLargeBoards)
+{
+    SimulationConfig config;
+    config.games = 20;
+    config.boardSize = 16;
+    config.maxShips = 5;
+
+    SimulationResult result = SimulationRunner(config).run();
+    EXPECT_EQ(result.completed, 20);
+}
@@ -0,0 +1,95 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <set>
+#include "DensityCache.h"
+#include "LayoutEnumerator.h"
+#include "Symmetry.h"
+#include "LayoutTestShots.h"
+
+TEST(SymmetryTests, MapsPlacementsOntoPlacements)
+{
+    for (int s = 0; s < Symmetry::COUNT; ++s) {
+        std::set<int> images;
+        for (int id = 0; id < PlacementTable::COUNT; ++id) {
+            const int image = Symmetry::PLACEMENTS[s][id];
+            images.insert(image);
+            EXPECT_EQ(PlacementTable::PLACEMENTS[image].mask, Symmetry::apply(PlacementTable::PLACEMENTS[id].mask, s));
+            EXPECT_EQ(Symmetry::PLACEMENTS[Symmetry::INVERSE[s]][image], id);
+        }
+        EXPECT_EQ(images.size(), static_cast<std::size_t>(PlacementTable::COUNT));
+    }
+}
+
+TEST(SymmetryTests, MirroredPositionsShareTheirCanonicalForm)
+{
+    LayoutObservation expected;
+    const int symmetry = Symmetry::canonicalize(SomeShots(), expected);
+    EXPECT_EQ(Symmetry::apply(SomeShots(), symmetry).hits, expected.hits);
+
+    for (int s = 0; s < Symmetry::COUNT; ++s) {
+        LayoutObservation canonical;
+        Symmetry::canonicalize(Symmetry::apply(SomeShots(), s), canonical);
+        EXPECT_EQ(canonical.hits, expected.hits);
+        EXPECT_EQ(canonical.misses, expected.misses);
+        EXPECT_EQ(canonical.heads, expected.heads);
+        EXPECT_EQ(Symmetry::canonical(Symmetry::apply(SomeShots().hits, s)), Symmetry::canonical(SomeShots().hits));
+    }
+}
+
+TEST(SymmetryTests, MirroredPositionsHaveMirroredDensity)
+{
+    LayoutEnumerator enumerator(2);
+    LayoutDensity density;
+    enumerator.countDensity(SomeShots(), density);
+    for (int s = 1; s < Symmetry::COUNT; ++s) {
+        LayoutDensity mirrored;
+        enumerator.countDensity(Symmetry::apply(SomeShots(), s), mirrored);
+        LayoutDensity expected = Symmetry::apply(density, s);
+        EXPECT_EQ(mirrored.layouts, expected.layouts);
+        EXPECT_EQ(mirrored.occupied, expected.occupied);
+        EXPECT_EQ(mirrored.heads, expected.heads);
+    }
+}
+
+TEST(SymmetryTests, CanonicalLayoutsCoverEveryLayoutOnce)
+{
+    for (int planes = 1; planes <= 3; ++planes) {
+        LayoutEnumerator enumerator(planes);
+        std::uint64_t represented = 0;
+        const std::uint64_t listed = enumerator.forEachCanonicalLayout([&](const std::uint16_t*, int, std::uint8_t images) {
+            EXPECT_TRUE(images & 1u);
+            represented += static_cast<std::uint64_t>(BitOps::popcount(images));
+        });
+
+        LayoutDensity density;
+        const std::uint64_t total = enumerator.countDensity(LayoutObservation(), density);
+        EXPECT_EQ(represented, total);
+        EXPECT_LT(listed * 7, total);
+    }
+}
+
+TEST(SymmetryTests, CacheAnswersForMirroredPositions)
+{
+    LayoutEnumerator enumerator(3);
+    DensityCache cache;
+    LayoutDensity density;
+    enumerator.countDensity(SomeShots(), density);
+    cache.insert(SomeShots(), density);
+
+    LayoutObservation unseen;
+    unseen.record(0, false, false);
+    EXPECT_FALSE(cache.find(unseen, density));
+
+    for (int s = 0; s < Symmetry::COUNT; ++s) {
+        const LayoutObservation mirrored = Symmetry::apply(SomeShots(), s);
+        LayoutDensity cached;
+        LayoutDensity counted;
+        ASSERT_TRUE(cache.find(mirrored, cached));
+        enumerator.countDensity(mirrored, counted);
+        EXPECT_EQ(cached.layouts, counted.layouts);
+        EXPECT_EQ(cached.occupied, counted.occupied);
+        EXPECT_EQ(cached.heads, counted.heads);
+    }
+    EXPECT_EQ(cache.getSize(), 1u);
+    EXPECT_EQ(cache.getHitCount(), static_cast<std::uint64_t>(Symmetry::COUNT));
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "Tournament.h"
+#include "RandomStrategies.h"
+#include "WorkStealingPool.h"
+
+TEST(WorkStealingPoolTests, RunsEveryItemOnce)
+{
+    WorkStealingPool pool(4);
+    std::vector<std::atomic<int>> seen(10000);
+
+    pool.run(10000, [&](int, std::uint32_t item) { seen[item].fetch_add(1); });
+
+    for (const auto& count : seen)
+        EXPECT_EQ(count.load(), 1);
+}
+
+TEST(WorkStealingPoolTests, IdleWorkersStealFromSlowOnes)
+{
+    WorkStealingPool pool(4);
+    std::atomic<int> done{ 0 };
+
+    // all the expensive items start in worker 0's range
+    pool.run(400, [&](int, std::uint32_t item) {
+        volatile int spin = 0;
+        for (int i = 0; i < (item < 100 ? 20000 : 10); ++i)
+            spin = spin + 1;
+        done.fetch_add(1);
+    });
+
+    EXPECT_EQ(done.load(), 400);
+    EXPECT_GT(pool.getStealCount(), 0u);
+}
+
+TEST(WorkStealingPoolTests, HandlesEmptyRun)
+{
+    WorkStealingPool pool(3);
+    int calls = 0;
+    pool.run(0, [&](int, std::uint32_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(TournamentTests, RoundRobinCountsEveryMatch)
+{
+    TournamentConfig config;
+    config.gamesPerPairing = 50;
+    config.threads = 3;
+
+    Tournament tournament(config);
+    tournament.addEntry({ "random", nullptr, [] { return std::make_unique<RandomShooter>(); } });
+    tournament.addEntry({ "hunt", nullptr, [] { return std::make_unique<HuntShooter>(); } });
+    tournament.addEntry({ "random2", nullptr, nullptr });
+
+    TournamentResult result = tournament.run();
+    EXPECT_EQ(result.matches, 150u);
+    EXPECT_EQ(result.unfinished, 0u);
+
+    std::uint64_t wins = 0;
+    for (const auto& standing : result.standings) {
+        EXPECT_EQ(standing.games, 100u);
+        wins += standing.wins;
+    }
+    EXPECT_EQ(wins, 150u);
+    EXPECT_EQ(result.winsAgainst(0, 1) + result.winsAgainst(1, 0), 50u);
+}
+
+TEST(TournamentTests, ResultsDoNotDependOnThreadCount)
+{
+    TournamentConfig config;
+    config.gamesPerPairing = 100;
+    config.seed = 9;
+
+    config.threads = 1;
+    Tournament single(config);
+    config.threads = 4;
+    Tournament multi(config);
+    for (Tournament* t : { &single, &multi }) {
+        t->addEntry({ "random", nullptr, nullptr });
+        t->addEntry({ "hunt", nullptr, [] { return std::make_unique<HuntShooter>(); } });
+    }
+
+    EXPECT_EQ(single.run().wins, multi.run().wins);
+}